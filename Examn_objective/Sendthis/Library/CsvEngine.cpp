@@ -0,0 +1,156 @@
+// Implementation file of the C interface - libcsvengine
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "csvengine.h"
+#include "CsvInOut.hpp"
+#include "MedianFilter.hpp"
+#include "AdaptiveSort.hpp"
+#include <cstring>
+#include <numeric>
+//==============================================================================
+
+struct csv_table{
+    CsvClass Csv;
+};
+
+namespace {
+
+// Strides are given in bytes and must fall on whole elements.
+bool ToElements(int64_t Stride, std::size_t Size, std::ptrdiff_t& Elements) {
+    if (Stride % static_cast<int64_t>(Size) != 0) return false;
+    Elements = Stride / static_cast<int64_t>(Size);
+    return true;
+}
+
+bool ValidShape(const void* Data, int64_t Rows, int64_t Cols) {
+    return Data != nullptr && Rows >= 0 && Cols >= 0 && Rows <= INT32_MAX && Cols <= INT32_MAX;
+}
+
+} // namespace
+
+int csv_abi_version(void) { return CSV_ABI_VERSION; }
+
+csv_table* csv_open(const char* path, char delimiter) {
+    if (path == nullptr) return nullptr;
+    try {
+        std::ifstream Probe(path);
+        if (!Probe.is_open()) return nullptr;
+        csv_table* Table = new csv_table;
+        Table->Csv.UseQuiet(true);
+        Table->Csv.ReadData(path, delimiter);
+        return Table;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void csv_close(csv_table* table) { delete table; }
+
+int csv_shape(csv_table* table, int64_t* rows, int64_t* cols) {
+    if (table == nullptr || rows == nullptr || cols == nullptr) return CSV_ERR_ARGUMENT;
+    try {
+        const int Rows = table->Csv.RowCount();
+        const std::size_t Cols = (Rows > 0) ? table->Csv.GetRow(0).size() : 0;
+        for (int i = 1; i < Rows; ++i)
+            if (table->Csv.GetRow(i).size() != Cols) return CSV_ERR_SHAPE;
+        *rows = Rows;
+        *cols = Cols;
+        return CSV_OK;
+    } catch (...) {
+        return CSV_ERR_INTERNAL;
+    }
+}
+
+int csv_copy(csv_table* table, double* data, int64_t rows, int64_t cols,
+             int64_t row_stride, int64_t col_stride) {
+    if (table == nullptr || !ValidShape(data, rows, cols)) return CSV_ERR_ARGUMENT;
+    std::ptrdiff_t RowStep, ColStep;
+    if (!ToElements(row_stride, sizeof(double), RowStep) || !ToElements(col_stride, sizeof(double), ColStep))
+        return CSV_ERR_ARGUMENT;
+    try {
+        int64_t Rows, Cols;
+        int Status = csv_shape(table, &Rows, &Cols);
+        if (Status != CSV_OK) return Status;
+        if (Rows != rows || Cols != cols) return CSV_ERR_SHAPE;
+        for (int i = 0; i < Rows; ++i) {
+            const std::vector<double>& row = table->Csv.GetRow(i);
+            for (int j = 0; j < Cols; ++j) data[i * RowStep + j * ColStep] = row[j];
+        }
+        return CSV_OK;
+    } catch (...) {
+        return CSV_ERR_INTERNAL;
+    }
+}
+
+int csv_filter(double* data, int64_t rows, int64_t cols, int64_t row_stride, int64_t col_stride) {
+    if (!ValidShape(data, rows, cols)) return CSV_ERR_ARGUMENT;
+    StridedGrid Grid{data, static_cast<int>(rows), static_cast<int>(cols), 0, 0};
+    if (!ToElements(row_stride, sizeof(double), Grid.RowStride) || !ToElements(col_stride, sizeof(double), Grid.ColStride))
+        return CSV_ERR_ARGUMENT;
+    try {
+        std::vector<double> Window; // Sliding window m x n
+        IndexStack ZStack; // A stack for bad values indexes
+        for (int i = 0; i < Grid.Rows(); ++i)
+            RepairRow(Grid, i, Window, ZStack);
+        return CSV_OK;
+    } catch (...) {
+        return CSV_ERR_INTERNAL;
+    }
+}
+
+int csv_write(const char* path, char delimiter, const double* data, int64_t rows,
+              int64_t cols, int64_t row_stride, int64_t col_stride) {
+    if (path == nullptr || !ValidShape(data, rows, cols)) return CSV_ERR_ARGUMENT;
+    std::ptrdiff_t RowStep, ColStep;
+    if (!ToElements(row_stride, sizeof(double), RowStep) || !ToElements(col_stride, sizeof(double), ColStep))
+        return CSV_ERR_ARGUMENT;
+    try {
+        std::ofstream Probe(path);
+        if (!Probe.is_open()) return CSV_ERR_IO;
+        Probe.close();
+        // WriteData takes rows, the text output is what Task1App writes.
+        Array Rows(rows, std::vector<double>(cols));
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j) Rows[i][j] = data[i * RowStep + j * ColStep];
+        CsvClass Csv;
+        Csv.UseQuiet(true);
+        Csv.WriteData(Rows, path, delimiter);
+        return CSV_OK;
+    } catch (...) {
+        return CSV_ERR_INTERNAL;
+    }
+}
+
+int cosort_int32(int32_t* keys, int64_t n, int64_t key_stride,
+                 void* payload, int64_t item_size, int64_t payload_stride) {
+    if (keys == nullptr || n < 0 || n > INT32_MAX) return CSV_ERR_ARGUMENT;
+    if (n > 0 && payload == nullptr) return CSV_ERR_ARGUMENT;
+    if (item_size <= 0) return CSV_ERR_ARGUMENT;
+    std::ptrdiff_t KeyStep;
+    if (!ToElements(key_stride, sizeof(int32_t), KeyStep)) return CSV_ERR_ARGUMENT;
+    try {
+        std::vector<int> Order(n);
+        std::iota(Order.begin(), Order.end(), 0);
+        auto Less = [keys, KeyStep](int a, int b) { return keys[a * KeyStep] < keys[b * KeyStep]; };
+        if (LooksPresorted(Order, Less))
+            SortIndexAdaptive(Order, Less);
+        else
+            std::stable_sort(Order.begin(), Order.end(), Less);
+
+        // Gather through copies of the inputs.
+        std::vector<int32_t> Keys(n);
+        std::vector<char> Items(n * item_size);
+        char* Payload = static_cast<char*>(payload);
+        for (int64_t i = 0; i < n; ++i) {
+            Keys[i] = keys[i * KeyStep];
+            memcpy(&Items[i * item_size], Payload + i * payload_stride, item_size);
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            keys[i * KeyStep] = Keys[Order[i]];
+            memcpy(Payload + i * payload_stride, &Items[Order[i] * item_size], item_size);
+        }
+        return CSV_OK;
+    } catch (...) {
+        return CSV_ERR_INTERNAL;
+    }
+}
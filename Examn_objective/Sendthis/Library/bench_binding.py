@@ -0,0 +1,58 @@
+#!/usr/bin/python
+"""Library calls against Task1App / Task2App subprocesses exchanging files.
+
+usage: bench_binding.py <Task1App> <Task2App>   (libcsvengine as in csvengine.py)
+Per-call overhead is measured on a 3x3 matrix, throughput on 2000x500.
+"""
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import numpy as np
+import csvengine
+
+
+def timed(work, repeat):
+    start = time.perf_counter()
+    for _ in range(repeat):
+        work()
+    return (time.perf_counter() - start) / repeat
+
+
+def subprocess_filter(app, matrix, folder):
+    # What the services do today: CSV file in, Task1App, CSV file out.
+    source = os.path.join(folder, "in.csv")
+    target = os.path.join(folder, "out.csv")
+    np.savetxt(source, matrix, delimiter=";", fmt="%g")
+    subprocess.run([app, source, target], check=True, stdout=subprocess.DEVNULL)
+    return np.loadtxt(target, delimiter=";", ndmin=2)
+
+
+def library_filter(matrix):
+    return csvengine.filter(matrix.copy())
+
+
+def main():
+    task1, task2 = sys.argv[1], sys.argv[2]
+    random = np.random.default_rng(42)
+    with tempfile.TemporaryDirectory() as folder:
+        for rows, cols, repeat in ((3, 3, 20), (2000, 500, 3)):
+            matrix = random.integers(0, 10, size=(rows, cols)).astype(np.float64)
+            same = np.array_equal(subprocess_filter(task1, matrix, folder), library_filter(matrix))
+            process = timed(lambda: subprocess_filter(task1, matrix, folder), repeat)
+            library = timed(lambda: library_filter(matrix), repeat * 50)
+            print("filter %dx%d: subprocess %.3f ms, library %.3f ms (%.0fx), %.1f MB/s in process, %s"
+                  % (rows, cols, process * 1e3, library * 1e3, process / library,
+                     matrix.nbytes / library / 1e6, "same result" if same else "RESULTS DIFFER"))
+
+        # Co-sort: the subprocess can only sort its built-in sample.
+        process = timed(lambda: subprocess.run([task2], check=True, stdout=subprocess.DEVNULL), 20)
+        keys = random.integers(0, 1 << 30, size=1000000).astype(np.int32)
+        payload = np.arange(len(keys), dtype=np.float64)
+        library = timed(lambda: csvengine.cosort(keys.copy(), payload.copy()), 5)
+        print("cosort: Task2App call %.3f ms, library 1e6 keys %.3f ms" % (process * 1e3, library * 1e3))
+
+
+if __name__ == "__main__":
+    main()
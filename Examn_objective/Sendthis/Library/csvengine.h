@@ -0,0 +1,59 @@
+/* C interface of the Task1 CSV engine and the Task2 co-sort - libcsvengine
+ * Author: Salah Eddine Ghamri
+ *
+ * Stable ABI: plain C types only, no exception crosses it, every call
+ * returns CSV_OK or a negative error code. Matrices are caller owned
+ * buffers of doubles described by a pointer, a shape and strides in bytes
+ * (element (i, j) is at (char*)data + i * row_stride + j * col_stride), which
+ * is the NumPy layout, so arrays are passed without copying.
+ */
+#ifndef CSVENGINE_H
+#define CSVENGINE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CSV_ABI_VERSION 1
+
+/* Only these functions are exported, the C++ inside stays private. */
+#define CSV_API __attribute__((visibility("default")))
+
+#define CSV_OK 0
+#define CSV_ERR_ARGUMENT -1   /* null pointer, bad shape or stride */
+#define CSV_ERR_IO -2         /* file cannot be opened */
+#define CSV_ERR_SHAPE -3      /* rows of different lengths, or buffer too small */
+#define CSV_ERR_INTERNAL -4   /* unexpected failure (out of memory...) */
+
+typedef struct csv_table csv_table;
+
+CSV_API int csv_abi_version(void);
+
+/* Reads a CSV file (CsvClass::ReadData). NULL if it cannot be opened. */
+CSV_API csv_table* csv_open(const char* path, char delimiter);
+CSV_API void csv_close(csv_table* table);
+CSV_API int csv_shape(csv_table* table, int64_t* rows, int64_t* cols);
+/* Copies the table into a rows x cols buffer, shape must match csv_shape. */
+CSV_API int csv_copy(csv_table* table, double* data, int64_t rows, int64_t cols,
+             int64_t row_stride, int64_t col_stride);
+
+/* CsvClass::FilterData in place: zeros repaired with the window median. */
+CSV_API int csv_filter(double* data, int64_t rows, int64_t cols,
+               int64_t row_stride, int64_t col_stride);
+
+/* CsvClass::WriteData, same text output. */
+CSV_API int csv_write(const char* path, char delimiter, const double* data, int64_t rows,
+              int64_t cols, int64_t row_stride, int64_t col_stride);
+
+/* Stable co-sort in place (SortFunctionAdaptive): the n keys are sorted
+ * ascending and the n payload items of item_size bytes follow them. */
+CSV_API int cosort_int32(int32_t* keys, int64_t n, int64_t key_stride,
+                 void* payload, int64_t item_size, int64_t payload_stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ifndef CSVENGINE_H */
@@ -0,0 +1,101 @@
+#!/usr/bin/python
+"""ctypes bindings of libcsvengine (see csvengine.h).
+
+NumPy arrays are handed to the library as pointer + shape + byte strides,
+nothing is copied. ctypes releases the GIL for the duration of every call,
+so other Python threads keep running while the engine computes.
+The library is looked up in $CSVENGINE_LIB, then next to this file and in
+./build.
+"""
+import ctypes
+import os
+import numpy as np
+
+_HERE = os.path.dirname(os.path.abspath(__file__))
+_CANDIDATES = [os.environ.get("CSVENGINE_LIB", ""),
+               os.path.join(_HERE, "libcsvengine.so"),
+               os.path.join(_HERE, "build", "libcsvengine.so")]
+_lib = None
+for _path in _CANDIDATES:
+    if _path and os.path.exists(_path):
+        _lib = ctypes.CDLL(_path)
+        break
+if _lib is None:
+    raise ImportError("libcsvengine.so not found, set CSVENGINE_LIB")
+
+ABI_VERSION = 1
+_ERRORS = {-1: "bad argument", -2: "file cannot be opened",
+           -3: "shape mismatch", -4: "internal error"}
+
+_i64 = ctypes.c_int64
+_ptr = ctypes.c_void_p
+_lib.csv_abi_version.restype = ctypes.c_int
+_lib.csv_open.argtypes = [ctypes.c_char_p, ctypes.c_char]
+_lib.csv_open.restype = _ptr
+_lib.csv_close.argtypes = [_ptr]
+_lib.csv_close.restype = None
+_lib.csv_shape.argtypes = [_ptr, ctypes.POINTER(_i64), ctypes.POINTER(_i64)]
+_lib.csv_copy.argtypes = [_ptr, _ptr, _i64, _i64, _i64, _i64]
+_lib.csv_filter.argtypes = [_ptr, _i64, _i64, _i64, _i64]
+_lib.csv_write.argtypes = [ctypes.c_char_p, ctypes.c_char, _ptr, _i64, _i64, _i64, _i64]
+_lib.cosort_int32.argtypes = [_ptr, _i64, _i64, _ptr, _i64, _i64]
+
+if _lib.csv_abi_version() != ABI_VERSION:
+    raise ImportError("libcsvengine ABI version %d, expected %d"
+                      % (_lib.csv_abi_version(), ABI_VERSION))
+
+
+def _check(status):
+    if status != 0:
+        raise RuntimeError("csvengine: " + _ERRORS.get(status, str(status)))
+
+
+def _matrix(array, writable):
+    # float64 2-D array, any strides; other arrays are refused, not copied.
+    if not isinstance(array, np.ndarray) or array.dtype != np.float64 or array.ndim != 2:
+        raise TypeError("expected a 2-D float64 numpy array")
+    if writable and not array.flags.writeable:
+        raise ValueError("array is read-only")
+    return (array.ctypes.data, array.shape[0], array.shape[1],
+            array.strides[0], array.strides[1])
+
+
+def read(path, delimiter=';'):
+    """CsvClass::ReadData into a new (rows, cols) float64 array."""
+    table = _lib.csv_open(path.encode(), delimiter.encode())
+    if not table:
+        _check(-2)
+    try:
+        rows, cols = _i64(), _i64()
+        _check(_lib.csv_shape(table, ctypes.byref(rows), ctypes.byref(cols)))
+        array = np.empty((rows.value, cols.value), dtype=np.float64)
+        _check(_lib.csv_copy(table, *_matrix(array, True)))
+        return array
+    finally:
+        _lib.csv_close(table)
+
+
+def filter(array):
+    """CsvClass::FilterData in place (views and transposes work)."""
+    _check(_lib.csv_filter(*_matrix(array, True)))
+    return array
+
+
+def write(path, array, delimiter=';'):
+    """CsvClass::WriteData of a float64 2-D array."""
+    _check(_lib.csv_write(path.encode(), delimiter.encode(), *_matrix(array, False)))
+
+
+def cosort(keys, payload):
+    """Stable in place co-sort: int32 keys ascending, payload rows follow."""
+    if not isinstance(keys, np.ndarray) or keys.dtype != np.int32 or keys.ndim != 1:
+        raise TypeError("keys must be a 1-D int32 numpy array")
+    if not isinstance(payload, np.ndarray) or payload.ndim < 1 or len(payload) != len(keys):
+        raise TypeError("payload must be a numpy array with one item per key")
+    if not keys.flags.writeable or not payload.flags.writeable:
+        raise ValueError("array is read-only")
+    item_size = payload.itemsize * int(np.prod(payload.shape[1:]))
+    if payload.ndim > 1 and not payload[0].flags.c_contiguous:
+        raise ValueError("payload items must be contiguous")
+    _check(_lib.cosort_int32(keys.ctypes.data, len(keys), keys.strides[0],
+                             payload.ctypes.data, item_size, payload.strides[0]))
@@ -0,0 +1,238 @@
+// Microbenchmarks of the Task1App kernels - Task1Bench
+// Author: Salah Eddine Ghamri
+// Usage: ./Task1Bench [--filter=<name>] [--out=<file>] ..., see MicroBench.hpp
+//==============================================================================
+#include "MicroBench.hpp"
+#include "MedianFilter.hpp"
+#include "SparseArray.hpp"
+#include "BlockStore.hpp"
+#include "StreamFilter.hpp"
+#include "CsvParse.hpp"
+#include "FixedWidth.hpp"
+#include "LazyRows.hpp"
+#include "OutputBuffer.hpp"
+#include "FanOutWriter.hpp"
+#include "PipeMode.hpp"
+#include "Metrics.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+//==============================================================================
+
+namespace {
+
+// Rows x Cols integers 1..9, a ZeroPercent share of them zero.
+Array MakeMatrix(int Rows, int Cols, int ZeroPercent) {
+    std::mt19937 Random(42);
+    Array Matrix(Rows, std::vector<double>(Cols));
+    for (std::vector<double>& row : Matrix)
+        for (double& Value : row)
+            Value = (static_cast<int>(Random() % 100) < ZeroPercent) ? 0 : 1 + Random() % 9;
+    return Matrix;
+}
+
+std::string MakeCsvLine(int Cols) {
+    std::string Line;
+    for (int j = 0; j < Cols; ++j) Line += std::to_string(j * 37 % 1000) + ".5;";
+    Line.back() = '\n';
+    return Line;
+}
+
+// The matrix as CSV text, every field Width digits wide when Width > 0.
+std::string MakeCsvText(const Array& Matrix, int Width) {
+    std::string Text;
+    char Field[16];
+    for (const std::vector<double>& row : Matrix) {
+        for (std::size_t j = 0; j < row.size(); ++j) {
+            snprintf(Field, sizeof(Field), "%0*d", Width, static_cast<int>(row[j]));
+            Text += Field;
+            Text += (j == row.size() - 1) ? '\n' : ';';
+        }
+    }
+    return Text;
+}
+
+// Scratch file for the kernels that read a path, removed at exit.
+const std::string& CsvFile() {
+    static std::string Path;
+    if (!Path.empty()) return Path;
+    Path = "/tmp/task1bench." + std::to_string(getpid()) + ".csv";
+    const std::string Text = MakeCsvText(MakeMatrix(500, 500, 10), 0);
+    FILE* File = fopen(Path.c_str(), "w");
+    if (File != nullptr) {
+        fwrite(Text.data(), 1, Text.size(), File);
+        fclose(File);
+    }
+    atexit([]() { unlink(CsvFile().c_str()); });
+    return Path;
+}
+
+} // namespace
+
+MICROBENCH(WindowMedian9) {
+    std::vector<double> Input = {5, 0, 3, 9, 1, 0, 7, 2, 8}, Window;
+    while (State.KeepRunning()) {
+        Window = Input;
+        double Median = WindowMedian(Window);
+        MicroBench::DoNotOptimize(Median);
+    }
+}
+
+// FilterData on a 500 x 500 matrix; the copy of the input is part of the time.
+MICROBENCH_ARGS(FilterDense, 1, 10, 50) {
+    const int Rows = 500, Cols = 500;
+    Array Matrix = MakeMatrix(Rows, Cols, State.Arg());
+    std::vector<double> Input, Work(Rows * Cols), Window;
+    for (const std::vector<double>& row : Matrix) Input.insert(Input.end(), row.begin(), row.end());
+    IndexStack ZStack;
+    while (State.KeepRunning()) {
+        memcpy(Work.data(), Input.data(), sizeof(double) * Input.size());
+        StridedGrid Grid{Work.data(), Rows, Cols, Cols, 1};
+        for (int i = 0; i < Rows; ++i) RepairRow(Grid, i, Window, ZStack);
+        MicroBench::ClobberMemory();
+    }
+}
+
+MICROBENCH_ARGS(FilterSparse, 90, 99) {
+    SparseArray Matrix(MakeMatrix(500, 500, State.Arg()));
+    while (State.KeepRunning()) {
+        SparseArray Filtered = FilterSparse(Matrix);
+        MicroBench::DoNotOptimize(Filtered);
+    }
+}
+
+MICROBENCH(StreamFilterRows) {
+    Array Matrix = MakeMatrix(500, 500, 10);
+    double Sum = 0;
+    while (State.KeepRunning()) {
+        StreamFilter Filter([&Sum](const std::vector<double>& row) { Sum += row[0]; });
+        for (const std::vector<double>& row : Matrix) Filter.Push(row);
+        Filter.Finish();
+    }
+    MicroBench::DoNotOptimize(Sum);
+}
+
+MICROBENCH(BlockStoreEncode) {
+    Array Matrix = MakeMatrix(500, 500, 10);
+    while (State.KeepRunning()) {
+        BlockStore Packed;
+        for (const std::vector<double>& row : Matrix) Packed.AppendRow(row);
+        Packed.Finish();
+        MicroBench::DoNotOptimize(Packed);
+    }
+}
+
+MICROBENCH(BlockStoreDecode) {
+    Array Matrix = MakeMatrix(500, 500, 10);
+    BlockStore Packed;
+    for (const std::vector<double>& row : Matrix) Packed.AppendRow(row);
+    Packed.Finish();
+    std::vector<double> Values;
+    while (State.KeepRunning()) {
+        for (int b = 0; b < Packed.Blocks(); ++b) Packed.DecodeBlock(b, Values);
+        MicroBench::DoNotOptimize(Values);
+    }
+}
+
+MICROBENCH_ARGS(ParseCsvLine, 10, 1000) {
+    std::string Line = MakeCsvLine(State.Arg());
+    std::vector<double> Row;
+    while (State.KeepRunning()) {
+        ParseLine(Line.data(), Line.data() + Line.size(), ';', Row);
+        MicroBench::DoNotOptimize(Row);
+    }
+}
+
+// Fixed width rows split between Arg threads.
+MICROBENCH_ARGS(ParseFixedWidth, 1, 4) {
+    const std::string Text = MakeCsvText(MakeMatrix(500, 500, 10), 4);
+    FixedLayout Layout;
+    DetectFixedWidth(Text.data(), Text.size(), ';', Layout);
+    Array Data;
+    while (State.KeepRunning()) {
+        ParseFixedWidth(Text.data(), Layout, ';', Data, State.Arg());
+        MicroBench::DoNotOptimize(Data);
+    }
+}
+
+// Line index of a file (--lazy), then a full parse with one thread.
+MICROBENCH(LazyIndex) {
+    const std::string& Path = CsvFile();
+    while (State.KeepRunning()) {
+        LazyRows Rows;
+        Rows.Open(Path, ';');
+        MicroBench::DoNotOptimize(Rows);
+    }
+}
+
+MICROBENCH(LazyParseAll) {
+    LazyRows Rows;
+    Rows.Open(CsvFile(), ';');
+    while (State.KeepRunning()) {
+        Array Data = Rows.ParseAll(1);
+        MicroBench::DoNotOptimize(Data);
+    }
+}
+
+// Formatting 250000 values into an OutputBuffer, written to /dev/null.
+MICROBENCH(OutputFormat) {
+    Array Matrix = MakeMatrix(500, 500, 10);
+    int Null = open("/dev/null", O_WRONLY);
+    while (State.KeepRunning()) {
+        OutputBuffer Out(Null);
+        for (const std::vector<double>& row : Matrix) {
+            for (std::size_t j = 0; j < row.size(); ++j) {
+                Out.Format(row[j]);
+                Out.Put((j == row.size() - 1) ? '\n' : ';');
+            }
+        }
+        Out.Flush();
+    }
+    close(Null);
+}
+
+// CSV, binary copy, statistics and checksum of a 500 x 500 matrix.
+MICROBENCH(FanOutWrite) {
+    Array Matrix = MakeMatrix(500, 500, 10);
+    const std::string Path = "/tmp/task1bench." + std::to_string(getpid()) + ".out";
+    FanOutOptions Options = {true, true, true, true};
+    while (State.KeepRunning()) WriteFanOut(Matrix, Path, ';', Options);
+    for (const char* Suffix : {"", ".bin", ".stats", ".sum"}) unlink((Path + Suffix).c_str());
+}
+
+// The whole pipe mode, from a file in memory to /dev/null.
+MICROBENCH(PipeFilter) {
+    const std::string Text = MakeCsvText(MakeMatrix(500, 500, 10), 0);
+    int In = memfd_create("task1bench", MFD_CLOEXEC);
+    int Null = open("/dev/null", O_WRONLY);
+    if (In < 0 || write(In, Text.data(), Text.size()) != static_cast<ssize_t>(Text.size())) return;
+    while (State.KeepRunning()) {
+        lseek(In, 0, SEEK_SET);
+        FilterPipe(In, Null);
+    }
+    close(In);
+    close(Null);
+}
+
+// A metric update against the plain atomic increment it should cost.
+MICROBENCH(AtomicAdd) {
+    std::atomic<uint64_t> Count(0);
+    while (State.KeepRunning())
+        for (int i = 0; i < 1000; ++i) Count.fetch_add(1, std::memory_order_relaxed);
+    MicroBench::DoNotOptimize(Count);
+}
+
+MICROBENCH(MetricsCounterAdd) {
+    static Metrics::Counter Count("bench.counter");
+    while (State.KeepRunning())
+        for (int i = 0; i < 1000; ++i) Count.Add();
+}
+
+int main(int args, char** argv) {
+    return MicroBench::Main(args, argv);
+}
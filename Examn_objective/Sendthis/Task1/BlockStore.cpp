@@ -0,0 +1,217 @@
+// Implementation file for BlockStore - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "BlockStore.hpp"
+#include <cmath>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+//==============================================================================
+
+namespace {
+
+// Block header, stored in the first HeaderWords words of every block.
+struct BlockHeader{
+    uint32_t Count;    // number of values
+    uint32_t Width;    // bits per packed delta, RawWidth if stored raw
+    int64_t First;     // first value
+    int64_t MinDelta;  // frame of reference of the deltas
+};
+const uint32_t RawWidth = 64;
+const std::size_t HeaderWords = sizeof(BlockHeader) / sizeof(uint32_t);
+const int Lanes = 4, PackValues = 128; // 4 lanes x 32 values
+
+// Packing works on 128 values: value k goes to lane k % 4, and each lane is
+// a bit stream of Width bits per value. Word j of the 4 lanes are stored
+// side by side, so a 128-bit register holds the same position of every lane.
+void Pack128(const uint32_t* In, uint32_t* Out, uint32_t Width) {
+    if (Width == 0) return;
+#ifdef __SSE2__
+    __m128i Acc = _mm_setzero_si128();
+    uint32_t Filled = 0;
+    for (int k = 0; k < PackValues / Lanes; ++k) {
+        __m128i Value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In + Lanes * k));
+        Acc = _mm_or_si128(Acc, _mm_sll_epi32(Value, _mm_cvtsi32_si128(Filled)));
+        Filled += Width;
+        if (Filled >= 32) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Out), Acc);
+            Out += Lanes;
+            Filled -= 32;
+            Acc = _mm_srl_epi32(Value, _mm_cvtsi32_si128(Width - Filled));
+        }
+    }
+#else
+    for (int l = 0; l < Lanes; ++l) {
+        uint64_t Acc = 0;
+        uint32_t Filled = 0, j = 0;
+        for (int k = 0; k < PackValues / Lanes; ++k) {
+            Acc |= static_cast<uint64_t>(In[Lanes * k + l]) << Filled;
+            Filled += Width;
+            if (Filled >= 32) {
+                Out[Lanes * j++ + l] = static_cast<uint32_t>(Acc);
+                Acc >>= 32;
+                Filled -= 32;
+            }
+        }
+    }
+#endif
+}
+
+void Unpack128(const uint32_t* In, uint32_t* Out, uint32_t Width) {
+    if (Width == 0) {
+        memset(Out, 0, PackValues * sizeof(uint32_t));
+        return;
+    }
+#ifdef __SSE2__
+    const __m128i Mask = _mm_set1_epi32(Width == 32 ? 0xFFFFFFFFu : (1u << Width) - 1);
+    __m128i Current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In));
+    uint32_t Used = 0;
+    for (int k = 0; k < PackValues / Lanes; ++k) {
+        __m128i Value = _mm_srl_epi32(Current, _mm_cvtsi32_si128(Used));
+        Used += Width;
+        if (Used >= 32 && k + 1 < PackValues / Lanes) {
+            // The value continues in (or the next one starts at) the next word.
+            In += Lanes;
+            Current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In));
+            Used -= 32;
+            if (Used > 0)
+                Value = _mm_or_si128(Value, _mm_sll_epi32(Current, _mm_cvtsi32_si128(Width - Used)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + Lanes * k), _mm_and_si128(Value, Mask));
+    }
+#else
+    const uint64_t Mask = (Width == 32) ? 0xFFFFFFFFull : (1ull << Width) - 1;
+    for (int l = 0; l < Lanes; ++l) {
+        uint64_t Acc = 0;
+        uint32_t Available = 0, j = 0;
+        for (int k = 0; k < PackValues / Lanes; ++k) {
+            if (Available < Width) {
+                Acc |= static_cast<uint64_t>(In[Lanes * j++ + l]) << Available;
+                Available += 32;
+            }
+            Out[Lanes * k + l] = static_cast<uint32_t>(Acc & Mask);
+            Acc >>= Width;
+            Available -= Width;
+        }
+    }
+#endif
+}
+
+bool IsSmallInteger(double Value) {
+    // Integers that a double holds exactly (-0.0 would lose its sign).
+    return std::fabs(Value) < 9007199254740992.0 && Value == std::floor(Value)
+        && !(Value == 0 && std::signbit(Value));
+}
+
+} // namespace
+
+BlockStore::BlockStore(): RowCount(0), ColCount(0), RowsPerBlock(1) {}
+
+void BlockStore::AppendRow(const std::vector<double>& Row) {
+    // All rows must have the same size, the first one sets it.
+    if (RowCount == 0 && Pending.empty()) {
+        ColCount = Row.size();
+        RowsPerBlock = (ColCount > 0 && ColCount < BlockValues) ? BlockValues / ColCount : 1;
+    }
+    Pending.insert(Pending.end(), Row.begin(), Row.end());
+    if (Pending.size() >= static_cast<std::size_t>(RowsPerBlock) * ColCount) EncodeBlock();
+}
+
+void BlockStore::Finish() {
+    if (!Pending.empty()) EncodeBlock();
+}
+
+void BlockStore::EncodeBlock() {
+    const std::size_t Count = Pending.size();
+    BlockHeader Header = {static_cast<uint32_t>(Count), RawWidth, 0, 0};
+    bool Packable = Count > 0;
+    for (std::size_t k = 0; Packable && k < Count; ++k)
+        Packable = IsSmallInteger(Pending[k]);
+
+    // Deltas and their frame of reference.
+    std::vector<uint32_t> Deltas;
+    if (Packable) {
+        int64_t MinDelta = 0, MaxDelta = 0;
+        for (std::size_t k = 1; k < Count; ++k) {
+            const int64_t Delta = static_cast<int64_t>(Pending[k]) - static_cast<int64_t>(Pending[k - 1]);
+            if (k == 1 || Delta < MinDelta) MinDelta = Delta;
+            if (k == 1 || Delta > MaxDelta) MaxDelta = Delta;
+        }
+        const uint64_t Range = static_cast<uint64_t>(MaxDelta - MinDelta);
+        Packable = Range <= 0xFFFFFFFFull;
+        if (Packable) {
+            Header.First = static_cast<int64_t>(Pending[0]);
+            Header.MinDelta = MinDelta;
+            Header.Width = 0;
+            while (Header.Width < 32 && (Range >> Header.Width) != 0) ++Header.Width;
+            // Padded to a whole number of 128 value groups.
+            Deltas.assign((Count - 1 + PackValues - 1) / PackValues * PackValues, 0);
+            for (std::size_t k = 1; k < Count; ++k)
+                Deltas[k - 1] = static_cast<uint32_t>(static_cast<int64_t>(Pending[k])
+                              - static_cast<int64_t>(Pending[k - 1]) - MinDelta);
+        }
+    }
+    if (!Packable) Header.Width = RawWidth;
+
+    Offsets.push_back(Words.size());
+    Words.resize(Words.size() + HeaderWords);
+    memcpy(&Words[Offsets.back()], &Header, sizeof(Header));
+    if (Packable) {
+        for (std::size_t g = 0; g < Deltas.size(); g += PackValues) {
+            const std::size_t At = Words.size();
+            Words.resize(At + Lanes * Header.Width);
+            Pack128(&Deltas[g], &Words[At], Header.Width);
+        }
+    } else {
+        const std::size_t At = Words.size();
+        Words.resize(At + Count * sizeof(double) / sizeof(uint32_t));
+        memcpy(&Words[At], Pending.data(), Count * sizeof(double));
+    }
+    RowCount += Count / (ColCount > 0 ? ColCount : 1);
+    Pending.clear();
+}
+
+void BlockStore::DecodeBlock(int b, std::vector<double>& Out) const {
+    BlockHeader Header;
+    const uint32_t* In = &Words[Offsets[b]];
+    memcpy(&Header, In, sizeof(Header));
+    In += HeaderWords;
+    Out.resize(Header.Count);
+    if (Header.Width == RawWidth) {
+        memcpy(Out.data(), In, Header.Count * sizeof(double));
+        return;
+    }
+
+    uint32_t Deltas[PackValues];
+    int64_t Value = Header.First;
+    Out[0] = static_cast<double>(Value);
+    for (std::size_t k = 1; k < Header.Count; k += PackValues) {
+        Unpack128(In, Deltas, Header.Width);
+        In += Lanes * Header.Width;
+        const std::size_t Stop = (k + PackValues < Header.Count) ? k + PackValues : Header.Count;
+        for (std::size_t e = k; e < Stop; ++e) {
+            Value += static_cast<int64_t>(Deltas[e - k]) + Header.MinDelta;
+            Out[e] = static_cast<double>(Value);
+        }
+    }
+}
+
+std::size_t BlockStore::CompressedBytes() const {
+    return Words.size() * sizeof(uint32_t) + Offsets.size() * sizeof(std::size_t);
+}
+
+std::size_t BlockStore::RawBytes() const {
+    return static_cast<std::size_t>(RowCount) * ColCount * sizeof(double);
+}
+
+std::vector< std::vector<double> > BlockStore::ToDense() const {
+    std::vector< std::vector<double> > Dense;
+    std::vector<double> Values;
+    for (int b = 0; b < Blocks(); ++b) {
+        DecodeBlock(b, Values);
+        for (std::size_t k = 0; k < Values.size(); k += ColCount)
+            Dense.emplace_back(Values.begin() + k, Values.begin() + k + ColCount);
+    }
+    return Dense;
+}
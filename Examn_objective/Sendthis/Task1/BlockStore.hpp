@@ -0,0 +1,42 @@
+// Header file of BlockStore - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef BLOCKSTORE_HPP
+#define BLOCKSTORE_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+//==============================================================================
+
+// Compressed in-memory matrix: rows are grouped in blocks of about
+// BlockValues values. A block of integer values is stored as the deltas
+// between consecutive values, minus their minimum (frame of reference),
+// bit-packed 128 at a time with the smallest width that fits. Blocks that
+// do not fit that scheme are stored raw.
+class BlockStore{
+    int RowCount, ColCount, RowsPerBlock;
+    std::vector<uint32_t> Words;        // encoded blocks, one after another
+    std::vector<std::size_t> Offsets;   // first word of every block
+    std::vector<double> Pending;        // rows of the block being filled
+    void EncodeBlock();
+ public:
+     static const int BlockValues = 4096;
+     BlockStore();
+     // Rows must all have the same, non zero, size.
+     bool Accepts(std::size_t Size) const { return Size > 0 && (ColCount == 0 || Size == static_cast<std::size_t>(ColCount)); }
+     void AppendRow(const std::vector<double>& Row);
+     void Finish();
+     int Rows() const { return RowCount; }
+     int Cols() const { return ColCount; }
+     int Blocks() const { return Offsets.size(); }
+     int BlockRows() const { return RowsPerBlock; }
+     // Rows of block b, row-major, Cols() values per row.
+     void DecodeBlock(int b, std::vector<double>& Out) const;
+     std::size_t CompressedBytes() const;
+     std::size_t RawBytes() const;
+     std::vector< std::vector<double> > ToDense() const;
+};
+
+#endif // ifndef BLOCKSTORE_HPP
@@ -2,17 +2,144 @@
 // Author: Salah Eddine Ghamri
 //==============================================================================
 #include "CsvInOut.hpp"
+#include "CsvParse.hpp"
+#include "MedianFilter.hpp"
+#include "StreamFilter.hpp"
+#include "FixedWidth.hpp"
+#include "OutputBuffer.hpp"
+#include "FanOutWriter.hpp"
+#include "Metrics.hpp"
+#include "ShardedFilter.hpp"
+#include "Tuning.hpp"
+#include "PerfCounters.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
 //==============================================================================
 
+namespace {
+
+// Storage is chosen on the first SampleRows rows: sparse if at least
+// SparseThreshold of their values are zero.
+const std::size_t SampleRows = 256;
+const double SparseThreshold = 0.9;
+
+// Live metrics (see Metrics.hpp), created on first use.
+Metrics::Counter& RowsRead() {
+    static Metrics::Counter Rows("task1.rows_read");
+    return Rows;
+}
+Metrics::Counter& RowsWritten() {
+    static Metrics::Counter Rows("task1.rows_written");
+    return Rows;
+}
+Metrics::Progress& FilterProgress() {
+    static Metrics::Progress Rows("task1.filter_rows");
+    return Rows;
+}
+// Rows repaired between two progress updates.
+const int ProgressStep = 1024;
+
+} // namespace
+
 // CsvClass Constructor & Destructor
-CsvClass::CsvClass() {}
+CsvClass::CsvClass(): Mode(Storage::Dense), Pages(PagePolicy::Default), PrefaultPages(false), Shards(0),
+                      CopyCounters(nullptr), PassCounters(nullptr), CopyTime(0), PassTime(0), Quiet(false) {}
 CsvClass::~CsvClass() {}
 
+void CsvClass::Say(const char* Format, ...) const {
+    // printf unless Quiet.
+    if (Quiet) return;
+    va_list Arguments;
+    va_start(Arguments, Format);
+    vprintf(Format, Arguments);
+    va_end(Arguments);
+}
+
+void CsvClass::ChooseStorage() {
+    // Moves Data to sparse storage if the rows read so far are mostly zeros
+    // and all of the same size. Paged or sharded matrices (UsePages,
+    // UseShards) stay dense, both only apply to the dense FilterData.
+    if (Pages != PagePolicy::Default || PrefaultPages || Shards > 0) return;
+    std::size_t Zeros = 0, Values = 0;
+    for (const std::vector<double>& row : Data) {
+        if (row.size() != Data[0].size()) return;
+        for (double Value : row) Zeros += (Value == 0);
+        Values += row.size();
+    }
+    if (Values == 0 || Zeros < SparseThreshold * Values) return;
+
+    Say("Most values are zero, using sparse storage.\n");
+    Sparse = SparseArray(Data);
+    Array().swap(Data);
+    Mode = Storage::Sparse;
+}
+
+void CsvClass::UseDenseStorage() {
+    // Moves the rows to Data: rows of different sizes do not fit sparse or
+    // compressed storage, and some callers need every row of a lazy file.
+    if (Mode == Storage::Lazy) {
+        // Everything is needed: parse it all, in parallel.
+        Data = Lazy.ParseAll(ParseThreads());
+        Lazy.Close();
+    }
+    if (Mode == Storage::Sparse) Data = Sparse.ToDense();
+    if (Mode == Storage::Compressed) {
+        Packed.Finish();
+        Data = Packed.ToDense();
+    }
+    Sparse = SparseArray();
+    Packed = BlockStore();
+    Mode = Storage::Dense;
+}
+
+void CsvClass::StoreRow(const std::vector<double>& row) {
+    // Appends a parsed row to the current storage.
+    RowsRead().Add();
+    if (Mode == Storage::Sparse && static_cast<int>(row.size()) == Sparse.Cols) {
+        Sparse.AppendRow(row);
+        return;
+    }
+    if (Mode == Storage::Compressed && Packed.Accepts(row.size())) {
+        Packed.AppendRow(row);
+        return;
+    }
+    if (Mode != Storage::Dense) UseDenseStorage();
+    this->Data.push_back(row); //refering to the class variable
+    if (Data.size() == SampleRows) ChooseStorage();
+}
+
+bool CsvClass::ReadFixedWidth(const std::string& InputFilePath, char Delim) {
+    // Fast path of ReadData for files whose fields all have the same width:
+    // no delimiter search, and the rows are split between the cores.
+    if (Mode != Storage::Dense || !Data.empty()) return false;
+    MappedFile InputFile;
+    FixedLayout Layout;
+    if (!InputFile.Open(InputFilePath) || InputFile.Size() == 0) return false;
+    if (!DetectFixedWidth(InputFile.Data(), InputFile.Size(), Delim, Layout)) return false;
+
+    const unsigned Threads = ParseThreads();
+    if (!ParseFixedWidth(InputFile.Data(), Layout, Delim, Data, Threads)) {
+        // Not fixed width after all: the general path starts over.
+        Data.clear();
+        return false;
+    }
+    Say("Input file is opened.\n");
+    Say("Fixed width fields, %zu rows parsed by %u threads.\n", Layout.Rows, Threads);
+    RowsRead().Add(Layout.Rows);
+    ChooseStorage();
+    return true;
+}
+
 void CsvClass::ReadData(std::string InputFilePath, char Delim) {
     //To Read from a file. It takes the file path and the delimiter character.
+    if (ReadFixedWidth(InputFilePath, Delim)) return;
     std::fstream InputFile(InputFilePath, std::ios::in);
     if (InputFile.is_open()) {
-        printf("Input file is opened.\n");
+        Say("Input file is opened.\n");
 
         std::string line, word;
         std::vector<double> row;
@@ -23,18 +150,96 @@ void CsvClass::ReadData(std::string InputFilePath, char Delim) {
             while (std::getline(linestream, word, Delim)) {
                 row.push_back(std::stod(word));
             }
-            this->Data.push_back(row); //refering to the class variable
+            StoreRow(row);
             row.clear();
             linestream.clear();
         }
+        if (Mode == Storage::Dense && Data.size() < SampleRows) ChooseStorage();
+        if (Mode == Storage::Compressed) Packed.Finish();
         InputFile.close();
     } else {
-        printf("Error opening Input file.\n");
+        Say("Error opening Input file.\n");
+    }
+}
+
+void CsvClass::ReadDataMapped(std::string InputFilePath, char Delim) {
+    // Same as ReadData, but the file is mapped and the byte range of every
+    // field is kept, so that WriteDataVerbatim can copy untouched fields.
+    Data.clear();
+    Sparse = SparseArray();
+    Packed = BlockStore();
+    Mode = Storage::Dense;
+    FieldBegin.clear();
+    FieldEnd.clear();
+    RowFields.assign(1, 0);
+    if (!Source.Open(InputFilePath)) {
+        Say("Error opening Input file.\n");
+        return;
+    }
+    Say("Input file is opened.\n");
+
+    const char* Base = Source.Data();
+    const std::size_t Size = Source.Size();
+    std::vector<double> row;
+    std::size_t Pos = 0;
+
+    while (Pos < Size) {
+        const char* NewLine = static_cast<const char*>(memchr(Base + Pos, '\n', Size - Pos));
+        std::size_t Next = (NewLine != nullptr) ? NewLine - Base + 1 : Size;
+        std::size_t Stop = (NewLine != nullptr) ? Next - 1 : Size;
+        if (Stop > Pos && Base[Stop - 1] == '\r') --Stop;
+
+        // Fields are split like std::getline does: no trailing empty field.
+        std::size_t Field = Pos;
+        while (Field < Stop) {
+            const char* Found = static_cast<const char*>(memchr(Base + Field, Delim, Stop - Field));
+            std::size_t End = (Found != nullptr) ? Found - Base : Stop;
+            FieldBegin.push_back(Field);
+            FieldEnd.push_back(End);
+            row.push_back(ParseField(Base + Field, Base + End));
+            Field = End + 1;
+        }
+        RowFields.push_back(FieldBegin.size());
+        this->Data.push_back(row);
+        row.clear();
+        Pos = Next;
+    }
+}
+
+void CsvClass::ReadDataLazy(std::string InputFilePath, char Delim) {
+    // Only the line index is built here, rows are parsed by GetRow when they
+    // are first used, or all at once by GetData.
+    Data.clear();
+    Sparse = SparseArray();
+    Packed = BlockStore();
+    if (!Lazy.Open(InputFilePath, Delim)) {
+        Say("Error opening Input file.\n");
+        Mode = Storage::Dense;
+        return;
     }
+    Say("Input file is opened.\n");
+    Mode = Storage::Lazy;
+}
+
+int CsvClass::RowCount() {
+    if (Mode == Storage::Lazy) return Lazy.Rows();
+    if (Mode == Storage::Sparse) return Sparse.Rows;
+    if (Mode == Storage::Compressed) return Packed.Rows();
+    return Data.size();
+}
+
+const std::vector<double>& CsvClass::GetRow(int i) {
+    // Row i. In lazy mode the reference is valid until the next GetRow.
+    if (Mode == Storage::Lazy) return Lazy.Row(i);
+    if (Mode != Storage::Dense) UseDenseStorage();
+    return Data[i];
 }
 
 Array CsvClass::GetData(){
     //A getter for Data variable
+    if (Mode == Storage::Lazy) UseDenseStorage();
+    if (Mode == Storage::Sparse) return Sparse.ToDense();
+    if (Mode == Storage::Compressed) return Packed.ToDense();
     return this->Data;
 }
 
@@ -44,86 +249,238 @@ void CsvClass::WriteData(Array data, std::string FilePath, char Delimiter){
     char EndLine;
 
     if (OutputFile.is_open()) {
-        printf("Writing to output file.\n");
+        Say("Writing to output file.\n");
         for (int i = 0; i < data.size(); ++i) {
         for (int j = 0; j < data[i].size(); ++j){
             EndLine = (j == data[i].size() - 1) ? '\n':Delimiter;
             OutputFile << data[i][j] << EndLine;
             }
+        RowsWritten().Add();
+        }
+    } else {
+        Say("Error in opening output file or in creating it.");
+    }
+}
+
+void CsvClass::WriteData(const SparseArray& data, std::string FilePath, char Delimiter){
+    //Same as WriteData for a sparse matrix, zeros are written back.
+    std::fstream OutputFile(FilePath, std::ios::out);
+    std::vector<double> row(data.Cols, 0.0);
+
+    if (OutputFile.is_open()) {
+        Say("Writing to output file.\n");
+        for (int i = 0; i < data.Rows; ++i) {
+            for (std::size_t k = data.RowPtr[i]; k < data.RowPtr[i + 1]; ++k)
+                row[data.ColIdx[k]] = data.Values[k];
+            for (int j = 0; j < data.Cols; ++j)
+                OutputFile << row[j] << ((j == data.Cols - 1) ? '\n' : Delimiter);
+            for (std::size_t k = data.RowPtr[i]; k < data.RowPtr[i + 1]; ++k)
+                row[data.ColIdx[k]] = 0.0;
         }
     } else {
-        printf("Error in opening output file or in creating it.");
+        Say("Error in opening output file or in creating it.");
     }
 }
 
+void CsvClass::WriteData(const BlockStore& data, std::string FilePath, char Delimiter){
+    //Same as WriteData for a compressed matrix, one block decoded at a time.
+    std::fstream OutputFile(FilePath, std::ios::out);
+    std::vector<double> Values;
+    const std::size_t Cols = data.Cols();
+
+    if (OutputFile.is_open()) {
+        Say("Writing to output file.\n");
+        for (int b = 0; b < data.Blocks(); ++b) {
+            data.DecodeBlock(b, Values);
+            for (std::size_t k = 0; k < Values.size(); ++k)
+                OutputFile << Values[k] << ((k % Cols == Cols - 1) ? '\n' : Delimiter);
+        }
+    } else {
+        Say("Error in opening output file or in creating it.");
+    }
+}
+
+void CsvClass::WriteDataFanOut(const Array& data, std::string FilePath, char Delimiter,
+                               bool Checksum){
+    // One pass over data for the CSV file, a binary copy (FilePath.bin),
+    // column statistics (FilePath.stats) and optionally a checksum.
+    Say("Writing to output file.\n");
+    FanOutOptions Options = {true, true, Checksum, Quiet};
+    if (!WriteFanOut(data, FilePath, Delimiter, Options))
+        Say("Error in opening output file or in creating it.");
+}
+
+void CsvClass::WriteDataVerbatim(const Array& data, std::string FilePath){
+    // Writes data keeping the original text of every field whose value did
+    // not change. The bytes between two repaired cells (usually whole runs
+    // of rows) are copied from the input file in one go, only the repaired
+    // cells are formatted.
+    bool SameShape = Source.IsOpen() && data.size() == Data.size();
+    for (std::size_t i = 0; SameShape && i < data.size(); ++i)
+        SameShape = data[i].size() == Data[i].size();
+    if (!SameShape) {
+        // Not read with ReadDataMapped (or reshaped): nothing to copy from.
+        WriteData(data, FilePath);
+        return;
+    }
+
+    int OutputFile = open(FilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (OutputFile < 0) {
+        Say("Error in opening output file or in creating it.");
+        return;
+    }
+    Say("Writing to output file.\n");
+    {
+        OutputBuffer Out(OutputFile);
+        const char* Base = Source.Data();
+        std::size_t Pending = 0; // first input byte not yet written
+
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            const std::size_t Row = RowFields[i];
+            for (std::size_t j = 0; j < data[i].size(); ++j) {
+                if (memcmp(&data[i][j], &Data[i][j], sizeof(double)) == 0) continue;
+                // Everything since the last repaired cell goes out unchanged.
+                Out.Copy(Source.Descriptor(), Base, Pending, FieldBegin[Row + j] - Pending);
+                Out.Format(data[i][j]);
+                Pending = FieldEnd[Row + j];
+            }
+        }
+        const std::size_t End = Source.Size();
+        Out.Copy(Source.Descriptor(), Base, Pending, End - Pending);
+        // WriteData always terminates the last row.
+        if (End > 0 && Base[End - 1] != '\n') Out.Put('\n');
+    }
+    close(OutputFile);
+}
+
+namespace {
+
+// Gives RepairRow access to an Array.
+struct ArrayGrid{
+    Array& A;
+    int Rows() const { return A.size(); }
+    int Cols(int i) const { return A[i].size(); }
+    double& At(int i, int j) { return A[i][j]; }
+};
+
+// Seconds taken by Work, also counted by Counters when it is not null.
+template<class F>
+double Measured(PerfCounters* Counters, F Work) {
+    auto Start = std::chrono::steady_clock::now();
+    if (Counters != nullptr) Counters->Start();
+    Work();
+    if (Counters != nullptr) Counters->Stop();
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+} // namespace
+
 Array CsvClass::FilterData(){
     // Applies a filter to eliminate Zero values.
     // Interpolation of correct values is based on a median filtering.
+    if (Mode == Storage::Sparse) return FilterSparse(Sparse).ToDense();
+    if (Mode == Storage::Compressed) return FilterCompressedData().ToDense();
+    if (Mode == Storage::Lazy) UseDenseStorage();
 
-    Array FData = this -> Data;
+    Array FData;
+    ShardSummary Summary;
+    if (Shards > 0 && FilterSharded(Data, FData, Shards, Summary)) {
+        Say("Sharded filter: %d workers, %.3f s (slowest worker %.3f s), %d rows repaired twice.\n",
+            Summary.Workers, Summary.Seconds, Summary.Slowest, Summary.Rerun);
+        return FData;
+    }
+    if (FilterPaged(FData)) return FData;
+    CopyTime = Measured(CopyCounters, [this, &FData]() { FData = this -> Data; });
+    ArrayGrid Grid{FData};
     std::vector<double> Window; // Sliding window m x n
-    int MaxM, MinM, MaxN, MinN; // Sliding window limits
-    std::vector<std::pair<int, int> > ZStack; // A stack for bad values indexes
-    double MedValue = 0.0;
-    int mid; // Index of median value
-
-    //General loop to iterate all array elements
-    for (int i = 0; i < FData.size(); ++i) {
-    for (int j = 0; j < FData[i].size(); ++j) {
-
-    // Calculating the limits the sliding window
-    MaxM = (i + 2 < FData.size()) ? i + 2 : FData.size();
-    MinM = (i - 1 >= 0) ? i - 1 : 0;
-    MaxN = (j + 2 < FData[i].size()) ? j + 2 : FData[i].size();
-    MinN = (j - 1 >= 0) ? j - 1 : 0;
-
-    // Clear Zero values stack
-    ZStack.clear();
-
-    // We check each array element
-    // We collect all of its neighbors
-    for ( int m = MinM; m < MaxM; ++m ) {
-    for ( int n = MinN; n < MaxN; ++n ) {
-        if ( FData[m][n] == 0 ){
-            // Stack bad values indexes
-            ZStack.emplace_back(m, n);
-            }
-        Window.push_back(FData[m][n]);
+    IndexStack ZStack; // A stack for bad values indexes
+
+    //General loop to iterate all array rows, see RepairRow.
+    PassTime = Measured(PassCounters, [&]() {
+        for (int i = 0; i < Grid.Rows(); ++i) {
+            RepairRow(Grid, i, Window, ZStack);
+            if (i % ProgressStep == 0) FilterProgress().Set(i, Grid.Rows());
         }
-    }
+    });
+    FilterProgress().Set(Grid.Rows(), Grid.Rows());
 
-    // calculate mediane =======================================================
-    // Sorting half of the Window elements is enough:
-    mid = (Window.size() + 1)/2;
-    for (int e = 0; e <= mid ; ++e)
-    {
-        int min = e;
-        for (int k = e + 1; k < Window.size(); ++k)
-        if (Window[k] < Window[min])
-            min = k;
-        const double temp = Window[e];
-        Window[e] = Window[min];
-        Window[min] = temp;
-    }
-
-    // Median value ============================================================
-    if ( Window.size() % 2 != 0 ) {
-        // if impaire take the middle value.
-        MedValue = Window[mid];
-    } else {
-        // else take the mean of the middle values.
-        MedValue = (Window[mid-1] + Window[mid])/2;
-    }
-    //==========================================================================
+    return FData;
+}
+
+bool CsvClass::FilterPaged(Array& FData){
+    // FilterData on one contiguous copy of the matrix, backed by the pages
+    // chosen with UsePages. Only for rectangular data and a non default policy.
+    if (Pages == PagePolicy::Default && !PrefaultPages) return false;
+    if (Data.empty() || Data[0].empty()) return false;
+    const int Rows = Data.size(), Cols = Data[0].size();
+    for (const std::vector<double>& row : Data)
+        if (static_cast<int>(row.size()) != Cols) return false;
+
+    PageBuffer Buffer;
+    if (!Buffer.Allocate(sizeof(double) * Rows * Cols, Pages)) return false;
+    Say("Filter matrix on %s pages.\n", PagePolicyName(Buffer.Backed()));
+    unsigned Threads = std::thread::hardware_concurrency();
+    if (Threads == 0) Threads = 1;
+    if (PrefaultPages) Buffer.Prefault(Threads);
 
-    // If there are bad values, replace them.
-    if ( ZStack.size() != 0 ) {
-        for (std::pair<int, int> &ZS : ZStack)
-        FData[ZS.first][ZS.second] = MedValue;
+    // Each thread copies its own rows in, first touches are spread too.
+    double* Matrix = static_cast<double*>(Buffer.Data());
+    CopyTime = Measured(CopyCounters, [this, Matrix, Rows, Cols, Threads]() {
+        std::vector<std::thread> Workers;
+        for (unsigned t = 0; t < Threads; ++t) {
+            Workers.emplace_back([this, Matrix, Rows, Cols, t, Threads]() {
+                for (unsigned i = Rows * t / Threads; i < Rows * (t + 1) / Threads; ++i)
+                    memcpy(Matrix + static_cast<std::size_t>(i) * Cols, Data[i].data(), sizeof(double) * Cols);
+            });
         }
-    // clear sliding window
-    Window.clear();
-    }} // End general loop
+        for (std::thread& Worker : Workers) Worker.join();
+    });
 
+    StridedGrid Grid{Matrix, Rows, Cols, Cols, 1};
+    std::vector<double> Window; // Sliding window m x n
+    IndexStack ZStack; // A stack for bad values indexes
+    PassTime = Measured(PassCounters, [&]() {
+        for (int i = 0; i < Rows; ++i) {
+            RepairRow(Grid, i, Window, ZStack);
+            if (i % ProgressStep == 0) FilterProgress().Set(i, Rows);
+        }
+    });
+    FilterProgress().Set(Rows, Rows);
+
+    FData.resize(Rows);
+    for (int i = 0; i < Rows; ++i)
+        FData[i].assign(Matrix + static_cast<std::size_t>(i) * Cols, Matrix + static_cast<std::size_t>(i + 1) * Cols);
+    return true;
+}
+
+SparseArray CsvClass::FilterSparseData(){
+    // FilterData without leaving sparse storage.
+    if (Mode != Storage::Sparse) return SparseArray(FilterData());
+    return FilterSparse(Sparse);
+}
+
+BlockStore CsvClass::FilterCompressedData(){
+    // FilterData without leaving compressed storage: blocks are decoded one
+    // at a time and only three rows are being repaired at once.
+    BlockStore FData;
+    if (Mode != Storage::Compressed) {
+        for (const std::vector<double>& row : FilterData()) FData.AppendRow(row);
+        FData.Finish();
+        return FData;
+    }
+
+    StreamFilter Filter([&FData](const std::vector<double>& row) { FData.AppendRow(row); });
+    std::vector<double> Values, row;
+    const int Cols = Packed.Cols();
+    for (int b = 0; b < Packed.Blocks(); ++b) {
+        Packed.DecodeBlock(b, Values);
+        for (std::size_t k = 0; k < Values.size(); k += Cols) {
+            row.assign(Values.begin() + k, Values.begin() + k + Cols);
+            Filter.Push(row);
+        }
+    }
+    Filter.Finish();
+    FData.Finish();
     return FData;
 }
@@ -10,19 +10,80 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include "MappedFile.hpp"
+#include "SparseArray.hpp"
+#include "BlockStore.hpp"
+#include "LazyRows.hpp"
+#include "PageAlloc.hpp"
+class PerfCounters;
 //==============================================================================
 // Type definitions:
 // We can use "using" too.
 typedef std::vector< std::vector<double> > Array;
+// Where the rows of a CsvClass are kept.
+enum class Storage { Dense, Sparse, Compressed, Lazy };
 //==============================================================================
 
 class CsvClass{
     Array Data;
+    // Round-trip mode: the mapped input and the byte range of every field.
+    // Row i owns the fields [RowFields[i], RowFields[i+1]).
+    MappedFile Source;
+    std::vector<std::size_t> FieldBegin, FieldEnd, RowFields;
+    // Used instead of Data when most values are zero (see ChooseStorage),
+    // or when compression was asked for.
+    Storage Mode;
+    SparseArray Sparse;
+    BlockStore Packed;
+    LazyRows Lazy;
+    // Pages backing the matrix FilterData works on, see FilterPaged. Set
+    // before reading: the data is then kept dense.
+    PagePolicy Pages;
+    bool PrefaultPages;
+    // Worker processes of FilterData (0: none), see FilterSharded. Set
+    // before reading: the data is then kept dense.
+    int Shards;
+    // Costs of the last FilterData, see CountFilter.
+    PerfCounters* CopyCounters;
+    PerfCounters* PassCounters;
+    double CopyTime, PassTime;
+    // No progress or error messages on stdout (embedded in the library).
+    bool Quiet;
+    void Say(const char* Format, ...) const __attribute__((format(printf, 2, 3)));
+    void ChooseStorage();
+    void StoreRow(const std::vector<double>& row);
+    void UseDenseStorage();
+    bool ReadFixedWidth(const std::string& FilePath, char Delimiter);
+    bool FilterPaged(Array& FData);
  public:
      CsvClass();
      void ReadData(std::string FilePath, char Delimiter = ';');
+     void ReadDataMapped(std::string FilePath, char Delimiter = ';');
+     void ReadDataLazy(std::string FilePath, char Delimiter = ';');
+     int RowCount();
+     const std::vector<double>& GetRow(int i);
      Array FilterData();
+     SparseArray FilterSparseData();
+     BlockStore FilterCompressedData();
+     void UseCompression() { Mode = Storage::Compressed; }
+     void UsePages(PagePolicy Policy, bool Prefault) { Pages = Policy; PrefaultPages = Prefault; }
+     void UseShards(int Workers) { Shards = Workers; }
+     void UseQuiet(bool Silent) { Quiet = Silent; }
+     // FilterData then counts apart the copy of the rows into the matrix it
+     // repairs (where the pages of a paged matrix are first touched) and
+     // the filter pass itself. Either may be null; times are always kept.
+     void CountFilter(PerfCounters* Copy, PerfCounters* Pass) { CopyCounters = Copy; PassCounters = Pass; }
+     double CopySeconds() const { return CopyTime; }
+     double FilterSeconds() const { return PassTime; }
+     bool IsSparse() const { return Mode == Storage::Sparse; }
+     bool IsCompressed() const { return Mode == Storage::Compressed; }
+     const BlockStore& GetCompressed() const { return Packed; }
      void WriteData(Array data, std::string FilePath, char Delimiter = ';');
+     void WriteData(const SparseArray& data, std::string FilePath, char Delimiter = ';');
+     void WriteData(const BlockStore& data, std::string FilePath, char Delimiter = ';');
+     void WriteDataVerbatim(const Array& data, std::string FilePath);
+     void WriteDataFanOut(const Array& data, std::string FilePath, char Delimiter = ';',
+                          bool Checksum = false);
      Array GetData();
      ~CsvClass();
 };
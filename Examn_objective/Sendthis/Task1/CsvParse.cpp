@@ -0,0 +1,30 @@
+// Implementation file of the CSV field parsing - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "CsvParse.hpp"
+#include <cstring>
+#include <string>
+//==============================================================================
+
+double ParseField(const char* Begin, const char* End) {
+    // Fields fit the stack buffer, longer ones (e.g. many digits or
+    // padding) are copied whole: cutting them could change the value.
+    char Buffer[64];
+    const std::size_t Length = End - Begin;
+    if (Length >= sizeof(Buffer)) return std::stod(std::string(Begin, End));
+    memcpy(Buffer, Begin, Length);
+    Buffer[Length] = '\0';
+    return std::stod(Buffer);
+}
+
+void ParseLine(const char* Begin, const char* End, char Delim, std::vector<double>& Row) {
+    if (End > Begin && End[-1] == '\n') --End;
+    if (End > Begin && End[-1] == '\r') --End;
+    Row.clear();
+    while (Begin < End) {
+        const char* Found = static_cast<const char*>(memchr(Begin, Delim, End - Begin));
+        const char* Stop = (Found != nullptr) ? Found : End;
+        Row.push_back(ParseField(Begin, Stop));
+        Begin = Stop + 1;
+    }
+}
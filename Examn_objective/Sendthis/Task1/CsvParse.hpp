@@ -0,0 +1,19 @@
+// Header file of the CSV field parsing - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef CSVPARSE_HPP
+#define CSVPARSE_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+//==============================================================================
+
+// std::stod on a field that is not NUL terminated (mapped file, buffer),
+// whatever its length.
+double ParseField(const char* Begin, const char* End);
+
+// Splits one line like std::getline does (no trailing empty field) and
+// converts the fields. A trailing "\n" or "\r\n" is ignored.
+void ParseLine(const char* Begin, const char* End, char Delim, std::vector<double>& Row);
+
+#endif // ifndef CSVPARSE_HPP
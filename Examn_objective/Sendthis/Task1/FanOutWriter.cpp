@@ -0,0 +1,176 @@
+// Implementation file of the fan-out writer - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "FanOutWriter.hpp"
+#include "OutputBuffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+//==============================================================================
+
+namespace {
+
+const std::size_t BlockRows = 4096;
+
+// One output of WriteFanOut. Consume gets consecutive blocks of rows.
+class Sink{
+ public:
+    virtual ~Sink() {}
+    virtual const char* Name() const = 0;
+    virtual void Consume(const Array& data, std::size_t First, std::size_t Last) = 0;
+    virtual bool Finish() = 0;
+};
+
+// Sinks writing to a file own its descriptor and a buffer on it.
+class FileSink : public Sink{
+ protected:
+    int Fd;
+    OutputBuffer Out;
+ public:
+    explicit FileSink(const std::string& FilePath):
+        Fd(open(FilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), Out(Fd) {}
+    ~FileSink() { if (Fd >= 0) close(Fd); }
+    bool Finish() override { return Fd >= 0 && Out.Flush(); }
+};
+
+class CsvSink : public FileSink{
+    char Delimiter;
+ public:
+    CsvSink(const std::string& FilePath, char Delim): FileSink(FilePath), Delimiter(Delim) {}
+    const char* Name() const override { return "csv"; }
+    void Consume(const Array& data, std::size_t First, std::size_t Last) override {
+        for (std::size_t i = First; i < Last; ++i)
+            for (std::size_t j = 0; j < data[i].size(); ++j) {
+                Out.Format(data[i][j]);
+                Out.Put((j == data[i].size() - 1) ? '\n' : Delimiter);
+            }
+    }
+};
+
+class BinarySink : public FileSink{
+    std::vector<double> Padding;
+ public:
+    BinarySink(const std::string& FilePath, const Array& data): FileSink(FilePath) {
+        // Header: rows, columns (shorter rows are padded with zeros).
+        uint64_t Header[2] = {data.size(), 0};
+        for (const std::vector<double>& row : data)
+            if (row.size() > Header[1]) Header[1] = row.size();
+        Out.Append(reinterpret_cast<const char*>(Header), sizeof(Header));
+        Padding.assign(Header[1], 0.0);
+    }
+    const char* Name() const override { return "binary"; }
+    void Consume(const Array& data, std::size_t First, std::size_t Last) override {
+        for (std::size_t i = First; i < Last; ++i) {
+            Out.Append(reinterpret_cast<const char*>(data[i].data()), data[i].size() * sizeof(double));
+            Out.Append(reinterpret_cast<const char*>(Padding.data()),
+                       (Padding.size() - data[i].size()) * sizeof(double));
+        }
+    }
+};
+
+class StatsSink : public Sink{
+    std::string Path;
+    char Delimiter;
+    // Welford running mean and variance, per column.
+    std::vector<std::size_t> Count;
+    std::vector<double> Min, Max, Mean, M2;
+ public:
+    StatsSink(const std::string& FilePath, char Delim): Path(FilePath), Delimiter(Delim) {}
+    const char* Name() const override { return "stats"; }
+    void Consume(const Array& data, std::size_t First, std::size_t Last) override {
+        for (std::size_t i = First; i < Last; ++i) {
+            if (data[i].size() > Count.size()) {
+                Count.resize(data[i].size(), 0);
+                Min.resize(data[i].size(), 0.0);
+                Max.resize(data[i].size(), 0.0);
+                Mean.resize(data[i].size(), 0.0);
+                M2.resize(data[i].size(), 0.0);
+            }
+            for (std::size_t j = 0; j < data[i].size(); ++j) {
+                const double Value = data[i][j];
+                if (Count[j] == 0 || Value < Min[j]) Min[j] = Value;
+                if (Count[j] == 0 || Value > Max[j]) Max[j] = Value;
+                ++Count[j];
+                const double Delta = Value - Mean[j];
+                Mean[j] += Delta / Count[j];
+                M2[j] += Delta * (Value - Mean[j]);
+            }
+        }
+    }
+    bool Finish() override {
+        FILE* Output = fopen(Path.c_str(), "w");
+        if (Output == nullptr) return false;
+        fprintf(Output, "column%ccount%cmin%cmax%cmean%cstddev\n",
+                Delimiter, Delimiter, Delimiter, Delimiter, Delimiter);
+        for (std::size_t j = 0; j < Count.size(); ++j)
+            fprintf(Output, "%zu%c%zu%c%g%c%g%c%g%c%g\n", j, Delimiter, Count[j], Delimiter,
+                    Min[j], Delimiter, Max[j], Delimiter, Mean[j], Delimiter,
+                    Count[j] > 1 ? std::sqrt(M2[j] / (Count[j] - 1)) : 0.0);
+        return fclose(Output) == 0;
+    }
+};
+
+class ChecksumSink : public Sink{
+    std::string Path;
+    uint64_t Hash;
+ public:
+    explicit ChecksumSink(const std::string& FilePath): Path(FilePath), Hash(14695981039346656037ull) {}
+    const char* Name() const override { return "checksum"; }
+    void Consume(const Array& data, std::size_t First, std::size_t Last) override {
+        // FNV-1a over the bytes of the values, row by row.
+        for (std::size_t i = First; i < Last; ++i) {
+            const unsigned char* Bytes = reinterpret_cast<const unsigned char*>(data[i].data());
+            for (std::size_t k = 0; k < data[i].size() * sizeof(double); ++k)
+                Hash = (Hash ^ Bytes[k]) * 1099511628211ull;
+        }
+    }
+    bool Finish() override {
+        FILE* Output = fopen(Path.c_str(), "w");
+        if (Output == nullptr) return false;
+        fprintf(Output, "fnv1a64 %016llx\n", static_cast<unsigned long long>(Hash));
+        return fclose(Output) == 0;
+    }
+};
+
+} // namespace
+
+bool WriteFanOut(const Array& data, const std::string& FilePath, char Delimiter,
+                 const FanOutOptions& Options) {
+    std::vector<std::unique_ptr<Sink> > Sinks;
+    Sinks.emplace_back(new CsvSink(FilePath, Delimiter));
+    if (Options.Binary) Sinks.emplace_back(new BinarySink(FilePath + ".bin", data));
+    if (Options.Stats) Sinks.emplace_back(new StatsSink(FilePath + ".stats", Delimiter));
+    if (Options.Checksum) Sinks.emplace_back(new ChecksumSink(FilePath + ".sum"));
+
+    std::vector<double> Seconds(Sinks.size());
+    std::vector<char> Done(Sinks.size());
+    std::vector<std::thread> Workers;
+    auto Start = std::chrono::steady_clock::now();
+    for (std::size_t s = 0; s < Sinks.size(); ++s) {
+        Workers.emplace_back([&, s]() {
+            auto SinkStart = std::chrono::steady_clock::now();
+            for (std::size_t First = 0; First < data.size(); First += BlockRows)
+                Sinks[s]->Consume(data, First, std::min(First + BlockRows, data.size()));
+            Done[s] = Sinks[s]->Finish();
+            std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - SinkStart;
+            Seconds[s] = Elapsed.count();
+        });
+    }
+    for (std::thread& Worker : Workers) Worker.join();
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    bool Ok = true;
+    for (std::size_t s = 0; s < Sinks.size(); ++s) Ok = Ok && Done[s];
+    if (Options.Quiet) return Ok;
+    printf("Fan-out:");
+    for (std::size_t s = 0; s < Sinks.size(); ++s)
+        printf(" %s %.3f s%s,", Sinks[s]->Name(), Seconds[s], Done[s] ? "" : " (failed)");
+    printf(" total %.3f s.\n", Elapsed.count());
+    return Ok;
+}
@@ -0,0 +1,29 @@
+// Header file of the fan-out writer - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef FANOUTWRITER_HPP
+#define FANOUTWRITER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <string>
+//==============================================================================
+// Type definitions:
+typedef std::vector< std::vector<double> > Array;
+//==============================================================================
+
+// Outputs written next to the CSV file.
+struct FanOutOptions{
+    bool Binary;    // FilePath.bin: row and column counts, then the values
+    bool Stats;     // FilePath.stats: count, min, max, mean, stddev per column
+    bool Checksum;  // FilePath.sum: FNV-1a 64 of the values
+    bool Quiet;     // no timing line on stdout
+};
+
+// Writes data as CSV to FilePath, plus the outputs chosen in Options.
+// Every output has its own thread and walks the same rows, block by block,
+// so the whole takes about as long as the slowest output alone.
+bool WriteFanOut(const Array& data, const std::string& FilePath, char Delimiter,
+                 const FanOutOptions& Options);
+
+#endif // ifndef FANOUTWRITER_HPP
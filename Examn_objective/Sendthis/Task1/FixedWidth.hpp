@@ -0,0 +1,33 @@
+// Header file of the fixed width CSV reader - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef FIXEDWIDTH_HPP
+#define FIXEDWIDTH_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <cstddef>
+//==============================================================================
+// Type definitions:
+typedef std::vector< std::vector<double> > Array;
+//==============================================================================
+
+// Files where every field has the same width and every row the same length,
+// e.g. "0012;0003;0450\n": field positions are computed, not searched.
+struct FixedLayout{
+    std::size_t RowBytes; // newline included
+    std::size_t Rows;
+    int Cols;
+    int Width;            // bytes per field, delimiter excluded
+    bool CarriageReturn;  // rows end with "\r\n"
+};
+
+// Checks the first rows and the file size. False for variable width files.
+bool DetectFixedWidth(const char* Base, std::size_t Size, char Delim, FixedLayout& Layout);
+
+// Parses every row, Threads threads each taking a range of rows. Returns
+// false (Data is then undefined) if a row turns out not to match Layout.
+bool ParseFixedWidth(const char* Base, const FixedLayout& Layout, char Delim,
+                     Array& Data, unsigned Threads);
+
+#endif // ifndef FIXEDWIDTH_HPP
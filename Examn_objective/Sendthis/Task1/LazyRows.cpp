@@ -0,0 +1,98 @@
+// Implementation file for LazyRows - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "LazyRows.hpp"
+#include "CsvParse.hpp"
+#include <cstring>
+#include <thread>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+//==============================================================================
+
+namespace {
+
+void IndexLines(const char* Base, std::size_t Size, std::vector<std::size_t>& LineStart) {
+    // Start offset of every line: 16 bytes are compared to '\n' at once and
+    // the matches are taken from the bit mask.
+    LineStart.clear();
+    if (Size == 0) return;
+    LineStart.push_back(0);
+    std::size_t Pos = 0;
+#ifdef __SSE2__
+    const __m128i NewLine = _mm_set1_epi8('\n');
+    for (; Pos + 16 <= Size; Pos += 16) {
+        __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Base + Pos));
+        unsigned Mask = _mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, NewLine));
+        while (Mask != 0) {
+            LineStart.push_back(Pos + __builtin_ctz(Mask) + 1);
+            Mask &= Mask - 1;
+        }
+    }
+#endif
+    for (; Pos < Size; ++Pos)
+        if (Base[Pos] == '\n') LineStart.push_back(Pos + 1);
+    // The last line may miss its newline; the end closes it either way.
+    if (LineStart.back() != Size) LineStart.push_back(Size);
+}
+
+} // namespace
+
+LazyRows::LazyRows(): Delim(';') {}
+
+bool LazyRows::Open(const std::string& FilePath, char Delimiter) {
+    Close();
+    Delim = Delimiter;
+    if (!File.Open(FilePath)) return false;
+    IndexLines(File.Data(), File.Size(), LineStart);
+    return true;
+}
+
+void LazyRows::Close() {
+    Recent.clear();
+    Cache.clear();
+    LineStart.clear();
+    File.Close();
+}
+
+const Array& LazyRows::Block(int b) {
+    auto Found = Cache.find(b);
+    if (Found != Cache.end()) {
+        Recent.splice(Recent.begin(), Recent, Found->second.first);
+        return Found->second.second;
+    }
+    if (static_cast<int>(Cache.size()) >= CacheBlocks) {
+        Cache.erase(Recent.back());
+        Recent.pop_back();
+    }
+    Recent.push_front(b);
+    auto& Entry = Cache[b];
+    Entry.first = Recent.begin();
+    Array& Rows = Entry.second;
+    const int First = b * BlockRows;
+    const int Last = (First + BlockRows < this->Rows()) ? First + BlockRows : this->Rows();
+    Rows.resize(Last - First);
+    for (int i = First; i < Last; ++i)
+        ParseLine(File.Data() + LineStart[i], File.Data() + LineStart[i + 1], Delim, Rows[i - First]);
+    return Rows;
+}
+
+const std::vector<double>& LazyRows::Row(int i) {
+    return Block(i / BlockRows)[i % BlockRows];
+}
+
+Array LazyRows::ParseAll(unsigned Threads) const {
+    Array Data(Rows());
+    if (Threads == 0) Threads = 1;
+    std::vector<std::thread> Workers;
+    for (unsigned t = 0; t < Threads; ++t) {
+        Workers.emplace_back([this, &Data, t, Threads]() {
+            const std::size_t First = Data.size() * t / Threads;
+            const std::size_t Last = Data.size() * (t + 1) / Threads;
+            for (std::size_t i = First; i < Last; ++i)
+                ParseLine(File.Data() + LineStart[i], File.Data() + LineStart[i + 1], Delim, Data[i]);
+        });
+    }
+    for (std::thread& Worker : Workers) Worker.join();
+    return Data;
+}
@@ -0,0 +1,42 @@
+// Header file of LazyRows - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef LAZYROWS_HPP
+#define LAZYROWS_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include "MappedFile.hpp"
+//==============================================================================
+// Type definitions:
+typedef std::vector< std::vector<double> > Array;
+//==============================================================================
+
+// A CSV file that is only indexed when opened: rows are parsed the first
+// time they are asked for, BlockRows at a time, and at most CacheBlocks
+// parsed blocks are kept (least recently used ones are dropped).
+class LazyRows{
+    MappedFile File;
+    char Delim;
+    std::vector<std::size_t> LineStart; // one per row, plus the file end
+    // LRU of parsed blocks: most recent first.
+    std::list<int> Recent;
+    std::unordered_map<int, std::pair<std::list<int>::iterator, Array> > Cache;
+    const Array& Block(int b);
+ public:
+     static const int BlockRows = 256;
+     static const int CacheBlocks = 64;
+     LazyRows();
+     bool Open(const std::string& FilePath, char Delimiter);
+     void Close();
+     int Rows() const { return LineStart.empty() ? 0 : LineStart.size() - 1; }
+     // The reference stays valid until the next call to Row.
+     const std::vector<double>& Row(int i);
+     // Every row, parsed by Threads threads.
+     Array ParseAll(unsigned Threads) const;
+};
+
+#endif // ifndef LAZYROWS_HPP
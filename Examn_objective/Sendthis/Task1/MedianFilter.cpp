@@ -0,0 +1,56 @@
+// Implementation file of the median repair kernel - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "MedianFilter.hpp"
+#include <algorithm>
+//==============================================================================
+
+double WindowMedian(std::vector<double>& Window) {
+    if (Window.size() == 1) return Window[0];
+
+    // calculate mediane =======================================================
+    // Sorting half of the Window elements is enough:
+    int mid = (Window.size() + 1)/2; // Index of median value
+    for (int e = 0; e <= mid ; ++e)
+    {
+        int min = e;
+        for (int k = e + 1; k < Window.size(); ++k)
+        if (Window[k] < Window[min])
+            min = k;
+        const double temp = Window[e];
+        Window[e] = Window[min];
+        Window[min] = temp;
+    }
+
+    // Median value ============================================================
+    if ( Window.size() % 2 != 0 ) {
+        // if impaire take the middle value.
+        return Window[mid];
+    }
+    // else take the mean of the middle values.
+    return (Window[mid-1] + Window[mid])/2;
+}
+
+double SparseWindowMedian(std::vector<double>& NonZero, int Zeros) {
+    // The sorted window is: negative values, the zeros, positive values.
+    // Windows hold at most 9 values: insertion sort.
+    for (std::size_t e = 1; e < NonZero.size(); ++e) {
+        const double Value = NonZero[e];
+        std::size_t k = e;
+        for (; k > 0 && Value < NonZero[k - 1]; --k) NonZero[k] = NonZero[k - 1];
+        NonZero[k] = Value;
+    }
+    const int Size = NonZero.size() + Zeros;
+    const int Negatives = std::lower_bound(NonZero.begin(), NonZero.end(), 0.0) - NonZero.begin();
+    auto Sorted = [&](int e) {
+        if (e < Negatives) return NonZero[e];
+        if (e < Negatives + Zeros) return 0.0;
+        return NonZero[e - Zeros];
+    };
+
+    if (Size == 1) return Sorted(0);
+    // Same element(s) as WindowMedian picks.
+    int mid = (Size + 1)/2;
+    if (Size % 2 != 0) return Sorted(mid);
+    return (Sorted(mid-1) + Sorted(mid))/2;
+}
@@ -0,0 +1,77 @@
+// Header file of the median repair kernel - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef MEDIANFILTER_HPP
+#define MEDIANFILTER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <utility>
+#include <cstddef>
+//==============================================================================
+// Type definitions:
+typedef std::vector<std::pair<int, int> > IndexStack;
+//==============================================================================
+
+// Median of a sliding window, as FilterData always computed it: only half of
+// the window is sorted. The window is reordered.
+double WindowMedian(std::vector<double>& Window);
+
+// Same value for a window made of the NonZero values plus Zeros zero values,
+// without materializing the zeros. NonZero is reordered.
+double SparseWindowMedian(std::vector<double>& NonZero, int Zeros);
+
+// Repairs the zero values around every element of row i.
+// Grid gives access to the matrix being filtered, it needs:
+//     int Rows() const;  int Cols(int i) const;  double& At(int i, int j);
+// Rows i - 1 and i + 1 are read and may be modified, so the result of a row
+// depends on the rows repaired before it (rows go in increasing order).
+template<class Grid>
+void RepairRow(Grid& G, int i, std::vector<double>& Window, IndexStack& ZStack) {
+    int MaxM, MinM, MaxN, MinN; // Sliding window limits
+    double MedValue = 0.0;
+
+    for (int j = 0; j < G.Cols(i); ++j) {
+    // Calculating the limits the sliding window
+    MaxM = (i + 2 < G.Rows()) ? i + 2 : G.Rows();
+    MinM = (i - 1 >= 0) ? i - 1 : 0;
+    MaxN = (j + 2 < G.Cols(i)) ? j + 2 : G.Cols(i);
+    MinN = (j - 1 >= 0) ? j - 1 : 0;
+
+    // Clear Zero values stack and sliding window
+    ZStack.clear();
+    Window.clear();
+
+    // We check each array element
+    // We collect all of its neighbors
+    for ( int m = MinM; m < MaxM; ++m ) {
+    for ( int n = MinN; n < MaxN; ++n ) {
+        if ( G.At(m, n) == 0 ){
+            // Stack bad values indexes
+            ZStack.emplace_back(m, n);
+            }
+        Window.push_back(G.At(m, n));
+        }
+    }
+    // Nothing to repair, the median is not needed.
+    if ( ZStack.size() == 0 ) continue;
+
+    MedValue = WindowMedian(Window);
+    // Replace the bad values.
+    for (std::pair<int, int> &ZS : ZStack)
+        G.At(ZS.first, ZS.second) = MedValue;
+    }
+}
+
+// RepairRow grid over a rectangular matrix held in one buffer:
+// element (i, j) is Base[i * RowStride + j * ColStride].
+struct StridedGrid{
+    double* Base;
+    int RowCount, ColCount;
+    std::ptrdiff_t RowStride, ColStride;
+    int Rows() const { return RowCount; }
+    int Cols(int) const { return ColCount; }
+    double& At(int i, int j) { return Base[i * RowStride + j * ColStride]; }
+};
+
+#endif // ifndef MEDIANFILTER_HPP
@@ -0,0 +1,72 @@
+// Implementation file for OutputBuffer - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "OutputBuffer.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+//==============================================================================
+
+OutputBuffer::OutputBuffer(int Descriptor, std::size_t Capacity):
+    Fd(Descriptor), Buffer(Capacity), Used(0), Good(true) {}
+
+OutputBuffer::~OutputBuffer() { Flush(); }
+
+void OutputBuffer::WriteAll(const char* Bytes, std::size_t Length) {
+    while (Good && Length > 0) {
+        ssize_t Done = write(Fd, Bytes, Length);
+        if (Done < 0) {
+            if (errno == EINTR) continue;
+            Good = false;
+            return;
+        }
+        Bytes += Done;
+        Length -= Done;
+    }
+}
+
+bool OutputBuffer::Flush() {
+    WriteAll(Buffer.data(), Used);
+    Used = 0;
+    return Good;
+}
+
+void OutputBuffer::Append(const char* Bytes, std::size_t Length) {
+    if (Used + Length > Buffer.size()) {
+        Flush();
+        if (Length > Buffer.size()) {
+            WriteAll(Bytes, Length);
+            return;
+        }
+    }
+    memcpy(Buffer.data() + Used, Bytes, Length);
+    Used += Length;
+}
+
+void OutputBuffer::Format(double Value) {
+    char Text[32];
+    int Length = snprintf(Text, sizeof(Text), "%g", Value);
+    Append(Text, Length);
+}
+
+void OutputBuffer::Copy(int InFd, const char* Base, std::size_t Offset, std::size_t Length) {
+    if (Length < MinCopyRange) {
+        Append(Base + Offset, Length);
+        return;
+    }
+    Flush();
+    off64_t From = Offset;
+    while (Good && Length > 0) {
+        ssize_t Done = copy_file_range(InFd, &From, Fd, nullptr, Length, 0);
+        if (Done <= 0) {
+            if (Done < 0 && errno == EINTR) continue;
+            // Not supported between these files: plain write from the map.
+            WriteAll(Base + From, Length);
+            return;
+        }
+        Length -= Done;
+    }
+}
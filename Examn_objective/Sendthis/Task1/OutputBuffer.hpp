@@ -0,0 +1,41 @@
+// Header file of OutputBuffer - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef OUTPUTBUFFER_HPP
+#define OUTPUTBUFFER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <cstddef>
+//==============================================================================
+
+// Buffered writer on a raw descriptor (the descriptor is not closed).
+// Large spans of an input file are handed to copy_file_range so that they
+// never pass through user space.
+class OutputBuffer{
+    int Fd;
+    std::vector<char> Buffer;
+    std::size_t Used;
+    bool Good;
+    static const std::size_t MinCopyRange = 1 << 16;
+    void WriteAll(const char* Bytes, std::size_t Length);
+ public:
+     explicit OutputBuffer(int Descriptor, std::size_t Capacity = 1 << 20);
+     OutputBuffer(const OutputBuffer&) = delete;
+     OutputBuffer& operator=(const OutputBuffer&) = delete;
+     ~OutputBuffer();
+     bool Flush();
+     void Append(const char* Bytes, std::size_t Length);
+     void Put(char c) {
+         if (Used == Buffer.size()) Flush();
+         Buffer[Used++] = c;
+     }
+     // Same text as "std::ostream << double" with the default precision.
+     void Format(double Value);
+     // Copies [Offset, Offset + Length) of the input file mapped at Base.
+     void Copy(int InFd, const char* Base, std::size_t Offset, std::size_t Length);
+     // False once a write failed.
+     bool IsGood() const { return Good; }
+};
+
+#endif // ifndef OUTPUTBUFFER_HPP
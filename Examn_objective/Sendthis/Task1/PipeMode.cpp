@@ -0,0 +1,78 @@
+// Implementation file of the pipe mode - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "PipeMode.hpp"
+#include "CsvParse.hpp"
+#include "OutputBuffer.hpp"
+#include "StreamFilter.hpp"
+#include "Metrics.hpp"
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+//==============================================================================
+
+namespace {
+
+void Prepare(int Fd, std::size_t ChunkBytes) {
+    // Bigger pipes mean fewer, larger reads and writes on both sides.
+    struct stat Info;
+    if (fstat(Fd, &Info) != 0) return;
+    if (S_ISFIFO(Info.st_mode)) fcntl(Fd, F_SETPIPE_SZ, static_cast<int>(ChunkBytes));
+    if (S_ISREG(Info.st_mode)) posix_fadvise(Fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+} // namespace
+
+bool FilterPipe(int InFd, int OutFd, char Delimiter, std::size_t ChunkBytes) {
+    // Live metrics, see Metrics.hpp.
+    static Metrics::Counter BytesIn("task1.pipe_bytes_in");
+    static Metrics::Counter RowsIn("task1.pipe_rows");
+    Prepare(InFd, ChunkBytes);
+    Prepare(OutFd, ChunkBytes);
+    OutputBuffer Out(OutFd, ChunkBytes);
+    StreamFilter Filter([&Out, Delimiter](const std::vector<double>& row) {
+        for (std::size_t j = 0; j < row.size(); ++j) {
+            Out.Format(row[j]);
+            Out.Put((j == row.size() - 1) ? '\n' : Delimiter);
+        }
+    });
+
+    std::vector<char> Buffer(ChunkBytes);
+    std::vector<double> row;
+    std::size_t Kept = 0; // start of a line still missing its end
+    for (;;) {
+        if (Kept == Buffer.size()) Buffer.resize(2 * Buffer.size()); // very long line
+        ssize_t Got = read(InFd, Buffer.data() + Kept, Buffer.size() - Kept);
+        if (Got < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (Got == 0) break;
+        BytesIn.Add(Got);
+
+        // Every complete line goes through the filter right away.
+        const std::size_t End = Kept + Got;
+        std::size_t Line = 0;
+        for (;;) {
+            const char* NewLine = static_cast<const char*>(memchr(Buffer.data() + Line, '\n', End - Line));
+            if (NewLine == nullptr) break;
+            const std::size_t Next = NewLine - Buffer.data() + 1;
+            ParseLine(Buffer.data() + Line, Buffer.data() + Next, Delimiter, row);
+            Filter.Push(row);
+            Line = Next;
+            RowsIn.Add();
+        }
+        Kept = End - Line;
+        memmove(Buffer.data(), Buffer.data() + Line, Kept);
+    }
+    if (Kept > 0) {
+        // Last line without newline.
+        ParseLine(Buffer.data(), Buffer.data() + Kept, Delimiter, row);
+        Filter.Push(row);
+    }
+    Filter.Finish();
+    return Out.Flush();
+}
@@ -0,0 +1,17 @@
+// Header file of the pipe mode - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef PIPEMODE_HPP
+#define PIPEMODE_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <cstddef>
+//==============================================================================
+
+// Reads CSV rows from InFd and writes the filtered rows to OutFd as they
+// become final: only the three rows of StreamFilter and one input chunk
+// are held in memory, reads and writes are ChunkBytes long (see
+// PipeChunkBytes in Tuning.hpp). Returns false on a read or write error.
+bool FilterPipe(int InFd, int OutFd, char Delimiter = ';', std::size_t ChunkBytes = 1 << 20);
+
+#endif // ifndef PIPEMODE_HPP
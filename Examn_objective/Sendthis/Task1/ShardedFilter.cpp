@@ -0,0 +1,194 @@
+// Implementation file of the sharded filter - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "ShardedFilter.hpp"
+#include "MedianFilter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+//==============================================================================
+
+namespace {
+
+// Rows of the first run kept to find where a second run meets it.
+const int MeetWindow = 64;
+
+// What every worker reports back.
+struct WorkerStats{
+    double Seconds;
+    int Rerun;                         // rows repaired a second time
+};
+
+bool SendAll(int Fd, const void* Data, std::size_t Bytes) {
+    const char* At = static_cast<const char*>(Data);
+    while (Bytes > 0) {
+        ssize_t Sent = write(Fd, At, Bytes);
+        if (Sent < 0 && errno == EINTR) continue;
+        if (Sent <= 0) return false;
+        At += Sent;
+        Bytes -= Sent;
+    }
+    return true;
+}
+
+bool ReceiveAll(int Fd, void* Data, std::size_t Bytes) {
+    char* At = static_cast<char*>(Data);
+    while (Bytes > 0) {
+        ssize_t Got = read(Fd, At, Bytes);
+        if (Got < 0 && errno == EINTR) continue;
+        if (Got <= 0) return false;
+        At += Got;
+        Bytes -= Got;
+    }
+    return true;
+}
+
+// One band: global rows [Begin, End) of Rows x Cols. Up and Down are the
+// sockets to the previous and next band (-1 at the ends). The final rows
+// [Begin - 1, End - 1) (End - 1 included for the last band) go to Out.
+bool RunWorker(const Array& Input, int Rows, int Cols, int Begin, int End, int Up, int Down,
+               double* Out, WorkerStats& Stats) {
+    auto Start = std::chrono::steady_clock::now();
+    const std::size_t RowBytes = sizeof(double) * Cols;
+    // Local rows [First, Last): the band and its halos.
+    const int First = Begin > 0 ? Begin - 1 : 0;
+    const int Last = End < Rows ? End + 1 : Rows;
+    const int Local = Last - First;
+    std::vector<double> Original(static_cast<std::size_t>(Local) * Cols);
+    auto Row = [Cols, First](std::vector<double>& M, int Global) {
+        return M.data() + static_cast<std::size_t>(Global - First) * Cols;
+    };
+    for (int i = Begin; i < End; ++i) memcpy(Row(Original, i), Input[i].data(), RowBytes);
+
+    // 1. Halo exchange, the upper side of each pair sends first.
+    if (Up >= 0 && (!ReceiveAll(Up, Row(Original, Begin - 1), RowBytes) ||
+                    !SendAll(Up, Row(Original, Begin), RowBytes))) return false;
+    if (Down >= 0 && (!SendAll(Down, Row(Original, End - 1), RowBytes) ||
+                      !ReceiveAll(Down, Row(Original, End), RowBytes))) return false;
+
+    // 2. First run, from the input as it is. Snapshots of the two rows that
+    // carry the state (rows k - 1 and k just before row k is repaired).
+    std::vector<double> Work = Original;
+    StridedGrid Grid{Work.data(), Local, Cols, Cols, 1};
+    std::vector<double> Window;
+    IndexStack ZStack;
+    const int Kept = std::min(MeetWindow, End - Begin);
+    std::vector<double> Snapshots(static_cast<std::size_t>(Kept) * 2 * Cols);
+    for (int i = Begin; i < End; ++i) {
+        RepairRow(Grid, i - First, Window, ZStack);
+        const int k = i + 1 - Begin; // state before row i + 1
+        if (k < Kept && i + 1 < Last)
+            memcpy(&Snapshots[static_cast<std::size_t>(k) * 2 * Cols], Row(Work, i), 2 * RowBytes);
+    }
+
+    // 3. The real state above the band, then ours for the band below.
+    Stats.Rerun = 0;
+    if (Up >= 0) {
+        std::vector<double> Carry(2 * Cols);
+        if (!ReceiveAll(Up, Carry.data(), 2 * RowBytes)) return false;
+        if (memcmp(Carry.data(), Row(Original, Begin - 1), 2 * RowBytes) != 0) {
+            // Repair again from the real state until it meets the first run.
+            std::vector<double> Again = Original;
+            memcpy(Row(Again, Begin - 1), Carry.data(), 2 * RowBytes);
+            StridedGrid Second{Again.data(), Local, Cols, Cols, 1};
+            int Met = End;
+            for (int i = Begin; i < End; ++i) {
+                RepairRow(Second, i - First, Window, ZStack);
+                ++Stats.Rerun;
+                const int k = i + 1 - Begin;
+                if (k < Kept && i + 1 < Last &&
+                    memcmp(&Snapshots[static_cast<std::size_t>(k) * 2 * Cols], Row(Again, i), 2 * RowBytes) == 0) {
+                    Met = i;
+                    break;
+                }
+            }
+            // Rows above the meeting point come from the second run; from
+            // it on both runs are the same (at the end: all of it).
+            const int Copied = (Met == End) ? Last : Met;
+            memcpy(Row(Work, First), Row(Again, First), static_cast<std::size_t>(Copied - First) * RowBytes);
+        }
+    }
+    if (Down >= 0 && !SendAll(Down, Row(Work, End - 1), 2 * RowBytes)) return false;
+
+    // Row i is final once row i + 1 was repaired.
+    const int OutLast = (End == Rows) ? Rows : End - 1;
+    memcpy(Out + static_cast<std::size_t>(First) * Cols, Row(Work, First),
+           static_cast<std::size_t>(OutLast - First) * RowBytes);
+    Stats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    return true;
+}
+
+} // namespace
+
+bool FilterSharded(const Array& Input, Array& Output, int Workers, ShardSummary& Summary) {
+    if (Input.empty() || Input[0].empty()) return false;
+    const int Rows = Input.size(), Cols = Input[0].size();
+    for (const std::vector<double>& row : Input)
+        if (static_cast<int>(row.size()) != Cols) return false;
+    if (Workers > Rows) Workers = Rows;
+    if (Workers < 1) Workers = 1;
+
+    // Output rows and worker reports, shared with the workers.
+    const std::size_t Matrix = sizeof(double) * Rows * Cols;
+    const std::size_t Bytes = Matrix + sizeof(WorkerStats) * Workers;
+    void* Shared = mmap(nullptr, Bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (Shared == MAP_FAILED) return false;
+    double* Out = static_cast<double*>(Shared);
+    WorkerStats* Stats = reinterpret_cast<WorkerStats*>(static_cast<char*>(Shared) + Matrix);
+
+    // Link b joins band b (its [0]) and band b + 1 (its [1]).
+    std::vector<int> Links(2 * (Workers - 1), -1);
+    bool Ok = true;
+    for (int b = 0; Ok && b + 1 < Workers; ++b)
+        Ok = socketpair(AF_UNIX, SOCK_STREAM, 0, &Links[2 * b]) == 0;
+
+    auto Start = std::chrono::steady_clock::now();
+    std::vector<pid_t> Children;
+    for (int b = 0; Ok && b < Workers; ++b) {
+        fflush(stdout);
+        pid_t Child = fork();
+        if (Child < 0) {
+            Ok = false;
+            break;
+        }
+        if (Child == 0) {
+            const int Up = (b > 0) ? Links[2 * (b - 1) + 1] : -1;
+            const int Down = (b + 1 < Workers) ? Links[2 * b] : -1;
+            for (int Fd : Links)
+                if (Fd != Up && Fd != Down && Fd >= 0) close(Fd);
+            const int Begin = static_cast<long long>(Rows) * b / Workers;
+            const int End = static_cast<long long>(Rows) * (b + 1) / Workers;
+            _exit(RunWorker(Input, Rows, Cols, Begin, End, Up, Down, Out, Stats[b]) ? 0 : 1);
+        }
+        Children.push_back(Child);
+    }
+    for (int Fd : Links)
+        if (Fd >= 0) close(Fd);
+    for (pid_t Child : Children) {
+        int Status;
+        while (waitpid(Child, &Status, 0) < 0 && errno == EINTR) {}
+        if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0) Ok = false;
+    }
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+    if (Ok) {
+        int Rerun = 0;
+        double Slowest = 0;
+        for (int b = 0; b < Workers; ++b) {
+            Rerun += Stats[b].Rerun;
+            if (Stats[b].Seconds > Slowest) Slowest = Stats[b].Seconds;
+        }
+        Summary = {Workers, Elapsed.count(), Slowest, Rerun};
+        Output.resize(Rows);
+        for (int i = 0; i < Rows; ++i)
+            Output[i].assign(Out + static_cast<std::size_t>(i) * Cols, Out + static_cast<std::size_t>(i + 1) * Cols);
+    }
+    munmap(Shared, Bytes);
+    return Ok;
+}
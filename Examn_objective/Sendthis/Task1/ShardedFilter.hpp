@@ -0,0 +1,37 @@
+// Header file of the sharded filter - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef SHARDEDFILTER_HPP
+#define SHARDEDFILTER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+//==============================================================================
+// Type definitions:
+typedef std::vector< std::vector<double> > Array;
+//==============================================================================
+
+// FilterData split between Workers processes, same result byte for byte.
+// The coordinator (the calling process) cuts the matrix into row bands and
+// forks one worker per band. Workers only touch their own band and talk to
+// their neighbours over Unix sockets, standing in for the network:
+//  1. halo exchange: every worker sends its first row up and its last row
+//     down, so it holds rows [begin - 1, end + 1) of the input;
+//  2. every band is repaired at once, assuming nothing above it changed;
+//  3. in band order, the state of the two boundary rows is handed down.
+//     Where it differs from the assumption, the band is repaired again from
+//     the top until its state meets the first run (usually after a row or
+//     two, see RepairRow: a row only depends on its neighbours), anything
+//     below is kept.
+// Rows come back through a shared mapping. Only for rectangular matrices;
+// returns false (nothing done) otherwise or when a worker fails. Prints
+// nothing, the caller reports Summary.
+struct ShardSummary{
+    int Workers;
+    double Seconds;        // wall time of the filter
+    double Slowest;        // seconds of the slowest worker
+    int Rerun;             // rows repaired twice
+};
+bool FilterSharded(const Array& Input, Array& Output, int Workers, ShardSummary& Summary);
+
+#endif // ifndef SHARDEDFILTER_HPP
@@ -0,0 +1,144 @@
+// Implementation file for SparseArray - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "SparseArray.hpp"
+#include "MedianFilter.hpp"
+#include <algorithm>
+//==============================================================================
+
+SparseArray::SparseArray(): Rows(0), Cols(0), RowPtr(1, 0) {}
+
+SparseArray::SparseArray(const Array& Dense): SparseArray() {
+    for (const std::vector<double>& Row : Dense) AppendRow(Row);
+}
+
+void SparseArray::AppendRow(const std::vector<double>& Row) {
+    // All rows must have the same size, the first one sets it.
+    if (Rows == 0) Cols = Row.size();
+    for (int j = 0; j < Cols; ++j) {
+        if (Row[j] != 0) {
+            ColIdx.push_back(j);
+            Values.push_back(Row[j]);
+        }
+    }
+    RowPtr.push_back(Values.size());
+    ++Rows;
+}
+
+Array SparseArray::ToDense() const {
+    Array Dense(Rows, std::vector<double>(Cols, 0.0));
+    for (int i = 0; i < Rows; ++i)
+        for (std::size_t k = RowPtr[i]; k < RowPtr[i + 1]; ++k)
+            Dense[i][ColIdx[k]] = Values[k];
+    return Dense;
+}
+
+namespace {
+
+// One row of the working set: the values spread over a dense row, and the
+// columns that were set, so clearing it costs the number of non-zeros.
+struct WorkRow{
+    std::vector<double> Values;
+    std::vector<int> Set;
+
+    explicit WorkRow(int Cols): Values(Cols, 0.0) {}
+    void Load(const SparseArray& A, int i) {
+        for (std::size_t k = A.RowPtr[i]; k < A.RowPtr[i + 1]; ++k) {
+            Values[A.ColIdx[k]] = A.Values[k];
+            Set.push_back(A.ColIdx[k]);
+        }
+    }
+    void Store(SparseArray& Out) {
+        std::sort(Set.begin(), Set.end());
+        Set.erase(std::unique(Set.begin(), Set.end()), Set.end());
+        for (int c : Set) {
+            Out.ColIdx.push_back(c);
+            Out.Values.push_back(Values[c]);
+            Values[c] = 0.0;
+        }
+        Set.clear();
+        Out.RowPtr.push_back(Out.Values.size());
+        ++Out.Rows;
+    }
+};
+
+} // namespace
+
+SparseArray FilterSparse(const SparseArray& In) {
+    // A window repairs something only if it holds a zero and its median is
+    // not zero, which needs at least one non-zero neighbor. Windows are
+    // visited in the same order as the dense filter, skipping the others.
+    SparseArray Out;
+    Out.Cols = In.Cols;
+    if (In.Rows == 0) return Out;
+
+    std::vector<WorkRow> Ring(3, WorkRow(In.Cols)); // rows i-1, i, i+1
+    auto Row = [&Ring](int i) -> WorkRow& { return Ring[i % 3]; };
+    std::vector<int> Candidates;
+    std::vector<double> NonZero;
+
+    Row(0).Load(In, 0);
+    if (In.Rows > 1) Row(1).Load(In, 1);
+
+    for (int i = 0; i < In.Rows; ++i) {
+        if (i >= 1 && i + 1 < In.Rows) Row(i + 1).Load(In, i + 1);
+        const int MinM = (i - 1 >= 0) ? i - 1 : 0;
+        const int MaxM = (i + 2 < In.Rows) ? i + 2 : In.Rows;
+
+        // Centers next to a non-zero value of rows i-1 .. i+1. Repairs can
+        // fill the matrix in, then every center is simply visited.
+        Candidates.clear();
+        std::size_t Filled = 0;
+        for (int m = MinM; m < MaxM; ++m) Filled += Row(m).Set.size();
+        if (3 * Filled >= static_cast<std::size_t>(In.Cols)) {
+            for (int c = 0; c < In.Cols; ++c) Candidates.push_back(c);
+        } else {
+            for (int m = MinM; m < MaxM; ++m) {
+                for (int c : Row(m).Set) {
+                    if (c > 0) Candidates.push_back(c - 1);
+                    Candidates.push_back(c);
+                    if (c + 1 < In.Cols) Candidates.push_back(c + 1);
+                }
+            }
+            std::sort(Candidates.begin(), Candidates.end());
+            Candidates.erase(std::unique(Candidates.begin(), Candidates.end()), Candidates.end());
+        }
+
+        // A repair creates non-zeros up to column j + 1, which makes the
+        // centers up to j + 2 candidates as well.
+        std::size_t Next = 0;
+        int ForcedUntil = -1;
+        for (int j = -1;;) {
+            while (Next < Candidates.size() && Candidates[Next] <= j) ++Next;
+            j = (j + 1 <= ForcedUntil) ? j + 1
+              : (Next < Candidates.size()) ? Candidates[Next] : In.Cols;
+            if (j >= In.Cols) break;
+
+            const int MinN = (j - 1 >= 0) ? j - 1 : 0;
+            const int MaxN = (j + 2 < In.Cols) ? j + 2 : In.Cols;
+            int Zeros = 0;
+            NonZero.clear();
+            for (int m = MinM; m < MaxM; ++m)
+                for (int n = MinN; n < MaxN; ++n) {
+                    const double Value = Row(m).Values[n];
+                    if (Value == 0) ++Zeros;
+                    else NonZero.push_back(Value);
+                }
+            if (Zeros == 0 || NonZero.empty()) continue;
+
+            const double MedValue = SparseWindowMedian(NonZero, Zeros);
+            if (MedValue == 0) continue;
+            for (int m = MinM; m < MaxM; ++m)
+                for (int n = MinN; n < MaxN; ++n)
+                    if (Row(m).Values[n] == 0) {
+                        Row(m).Values[n] = MedValue;
+                        Row(m).Set.push_back(n);
+                    }
+            ForcedUntil = j + 2;
+        }
+        // Row i-1 will not be touched anymore.
+        if (i >= 1) Row(i - 1).Store(Out);
+    }
+    Row(In.Rows - 1).Store(Out);
+    return Out;
+}
@@ -0,0 +1,35 @@
+// Header file of SparseArray - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef SPARSEARRAY_HPP
+#define SPARSEARRAY_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <cstddef>
+//==============================================================================
+// Type definitions:
+typedef std::vector< std::vector<double> > Array;
+//==============================================================================
+
+// Compressed sparse row storage of a matrix: only the non-zero values are
+// kept. Row i owns the entries [RowPtr[i], RowPtr[i+1]).
+struct SparseArray{
+    int Rows, Cols;
+    std::vector<std::size_t> RowPtr;
+    std::vector<int> ColIdx;
+    std::vector<double> Values;
+
+    SparseArray();
+    explicit SparseArray(const Array& Dense);
+    void AppendRow(const std::vector<double>& Row);
+    std::size_t NonZeros() const { return Values.size(); }
+    Array ToDense() const;
+};
+
+// Same result as CsvClass::FilterData on the dense matrix, but only the
+// windows that hold a non-zero value are visited: runtime and memory grow
+// with the number of non-zeros (plus one row of scratch).
+SparseArray FilterSparse(const SparseArray& In);
+
+#endif // ifndef SPARSEARRAY_HPP
@@ -0,0 +1,28 @@
+// Implementation file for StreamFilter - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "StreamFilter.hpp"
+//==============================================================================
+
+StreamFilter::StreamFilter(std::function<void(const std::vector<double>&)> Output):
+    Pushed(0), Emit(Output) {}
+
+void StreamFilter::Repair(int i) {
+    // Center row i is repaired once row i+1 is known (or there is none),
+    // after which row i-1 is final.
+    RepairRow(*this, i, Window, ZStack);
+    if (i >= 1) Emit(Ring[(i - 1) % 3]);
+}
+
+void StreamFilter::Push(const std::vector<double>& Row) {
+    Ring[Pushed % 3] = Row;
+    ++Pushed;
+    if (Pushed >= 2) Repair(Pushed - 2);
+}
+
+void StreamFilter::Finish() {
+    if (Pushed == 0) return;
+    Repair(Pushed - 1);
+    Emit(Ring[(Pushed - 1) % 3]);
+    Pushed = 0;
+}
@@ -0,0 +1,34 @@
+// Header file of StreamFilter - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef STREAMFILTER_HPP
+#define STREAMFILTER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <vector>
+#include <functional>
+#include "MedianFilter.hpp"
+//==============================================================================
+
+// FilterData on a stream of rows: only the rows i-1, i, i+1 are kept.
+// Rows are pushed in order and every row is handed to Emit as soon as no
+// later window can change it, with the same values FilterData gives.
+class StreamFilter{
+    std::vector<double> Ring[3];
+    int Pushed;
+    std::function<void(const std::vector<double>&)> Emit;
+    std::vector<double> Window;
+    IndexStack ZStack;
+    void Repair(int i);
+ public:
+     explicit StreamFilter(std::function<void(const std::vector<double>&)> Output);
+     void Push(const std::vector<double>& Row);
+     // No more rows: repairs and emits the last ones.
+     void Finish();
+     // Grid interface for RepairRow.
+     int Rows() const { return Pushed; }
+     int Cols(int i) const { return Ring[i % 3].size(); }
+     double& At(int i, int j) { return Ring[i % 3][j]; }
+};
+
+#endif // ifndef STREAMFILTER_HPP
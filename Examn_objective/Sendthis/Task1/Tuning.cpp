@@ -0,0 +1,78 @@
+// Implementation file of the tuned parameters - Task1App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Tuning.hpp"
+#include "FixedWidth.hpp"
+#include "PipeMode.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+//==============================================================================
+
+namespace {
+
+// Calibration inputs, a run takes tens of milliseconds. The pipe mode is
+// slower per row, it gets fewer.
+const int ParseRows = 100000;
+const int PipeRows = 20000;
+const int SampleCols = 10;
+
+template<class F>
+double Seconds(F Work) {
+    auto Start = std::chrono::steady_clock::now();
+    Work();
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+// Rows like the inputs of the app: small integers, one value in five zero.
+std::string SampleCsv(int Rows, bool FixedWidth) {
+    std::string Text;
+    char Field[16];
+    unsigned Seed = 42;
+    for (int i = 0; i < Rows; ++i) {
+        for (int j = 0; j < SampleCols; ++j) {
+            Seed = Seed * 1103515245u + 12345u;
+            const unsigned Value = ((Seed >> 16) % 5 == 0) ? 0 : (Seed >> 16) % 1000;
+            snprintf(Field, sizeof(Field), FixedWidth ? "%04u" : "%u", Value);
+            Text += Field;
+            Text += (j == SampleCols - 1) ? '\n' : ';';
+        }
+    }
+    return Text;
+}
+
+double TimeParse(long Threads) {
+    static const std::string Text = SampleCsv(ParseRows, true);
+    FixedLayout Layout;
+    Array Data;
+    DetectFixedWidth(Text.data(), Text.size(), ';', Layout);
+    return Seconds([&]() { ParseFixedWidth(Text.data(), Layout, ';', Data, Threads); });
+}
+
+double TimePipe(long ChunkBytes) {
+    // The whole pipe mode, from a file in memory to /dev/null.
+    static int Input = -1;
+    if (Input < 0) {
+        const std::string Text = SampleCsv(PipeRows, false);
+        Input = memfd_create("task1-tuning", MFD_CLOEXEC);
+        if (Input < 0 || write(Input, Text.data(), Text.size()) != static_cast<ssize_t>(Text.size())) return 1e9;
+    }
+    int Output = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (Output < 0) return 1e9;
+    lseek(Input, 0, SEEK_SET);
+    double Elapsed = Seconds([&]() { FilterPipe(Input, Output, ';', ChunkBytes); });
+    close(Output);
+    return Elapsed;
+}
+
+} // namespace
+
+void RegisterTuning() {
+    Autotune::Register("task1.parse_threads", std::max(1u, std::thread::hardware_concurrency()),
+                       Autotune::ThreadCandidates(), TimeParse);
+    Autotune::Register("task1.pipe_chunk", 1 << 20, {16 << 10, 64 << 10, 256 << 10, 1 << 20, 4 << 20}, TimePipe);
+}
@@ -0,0 +1,32 @@
+// Header file of the tuned parameters - Task1App
+// Author: Salah Eddine Ghamri
+#ifndef TUNING_HPP
+#define TUNING_HPP
+
+//==============================================================================
+// Included dependencies:
+#include "Autotune.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+//==============================================================================
+// Parameters picked per host by Autotune (see Autotune.hpp); until Load
+// has run, and in the library, they are the defaults.
+//==============================================================================
+
+// Threads parsing fixed width and lazy files, default one per core.
+inline unsigned ParseThreads() {
+    const long Cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1L, Autotune::Get("task1.parse_threads", Cores));
+}
+
+// Read and write size of the pipe mode, default 1 MiB.
+inline std::size_t PipeChunkBytes() {
+    return std::max(4096L, Autotune::Get("task1.pipe_chunk", 1 << 20));
+}
+
+// Registers the calibration runs of the parameters above, call it before
+// Autotune::Load.
+void RegisterTuning();
+
+#endif // ifndef TUNING_HPP
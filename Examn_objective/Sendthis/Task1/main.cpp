@@ -10,11 +10,48 @@
 # Version         : 1.0
 # Usage           : Compile using Cmake.
 # Notes           : Main takes two inputs: input file path and output file path.
+#                   "-" stands for stdin / stdout (pipe mode, no options):
+#                       cat in.csv | ./Task1App - - | gzip > out.csv.gz
+#                   Options after them:
+#                       --verbatim : untouched fields are copied byte for
+#                                    byte from the input file.
+#                       --compressed : rows are kept block compressed in
+#                                    memory, see BlockStore.
+#                       --lazy : the input is only indexed, then parsed by
+#                                    all cores at once.
+#                       --fanout : also writes <output>.bin and
+#                                    <output>.stats in the same pass.
+#                       --checksum : with --fanout, writes <output>.sum.
+#                       --pages=default|thp|huge : pages backing the matrix
+#                                    being filtered (huge falls back to thp).
+#                       --prefault : fault those pages in from all cores
+#                                    before filtering.
+#                                    Both report the time, dTLB misses and
+#                                    page faults of the copy in and of the
+#                                    filter pass. The matrix is then
+#                                    kept dense, not with --compressed.
+#                       --shards=N : filter with N worker processes, one
+#                                    band of rows each (same output), and
+#                                    report the filter time and that of
+#                                    the slowest worker. The matrix is
+#                                    then kept dense. Not with --pages,
+#                                    --prefault or --compressed.
+#                       --tune : calibrate the parsing threads and pipe
+#                                    chunk size of this host and save
+#                                    them, later runs use them (see
+#                                    Autotune.hpp).
 # C++_version     : C++14
 # //TODO          : ...
 # ==============================================================================
 */
 #include "CsvInOut.hpp"
+#include "PipeMode.hpp"
+#include "Tuning.hpp"
+#include "PerfCounters.hpp"
+#include <cstring>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
 
 // main variables
 // Data container object
@@ -23,14 +60,135 @@ CsvClass Data;
 int main(int args, char** argv) {
     // Main takes two inputs: input file path and output file path.
     // Argument number verification
-    if (args == 3) {
-        printf("'OK' Arguments provided.\n");
-    } else {
+    if (args < 3) {
         printf("Missing main arguments.\n");
         return EXIT_FAILURE;
     }
-    //Assigne the input file path.
-    Data.ReadData(argv[1]);
+    const bool ReadStdin = strcmp(argv[1], "-") == 0;
+    const bool WriteStdout = strcmp(argv[2], "-") == 0;
+    RegisterTuning();
+    if (ReadStdin || WriteStdout) {
+        // Pipe mode: rows are streamed, stdout only carries the data.
+        int In = ReadStdin ? STDIN_FILENO : open(argv[1], O_RDONLY);
+        int Out = WriteStdout ? STDOUT_FILENO : open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (In < 0 || Out < 0) {
+            fprintf(stderr, "Error opening Input or output file.\n");
+            return EXIT_FAILURE;
+        }
+        Autotune::Load(false, false); // a saved file only, never calibrates
+        if (!FilterPipe(In, Out, ';', PipeChunkBytes())) {
+            fprintf(stderr, "Error reading or writing the data.\n");
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+    printf("'OK' Arguments provided.\n");
+    bool Verbatim = false, Lazy = false, FanOut = false, Checksum = false;
+    bool PageReport = false, Prefault = false, Tune = false;
+    int Shards = 0;
+    PagePolicy Pages = PagePolicy::Default;
+    for (int i = 3; i < args; ++i) {
+        if (strcmp(argv[i], "--verbatim") == 0) {
+            Verbatim = true;
+        } else if (strcmp(argv[i], "--fanout") == 0) {
+            FanOut = true;
+        } else if (strcmp(argv[i], "--checksum") == 0) {
+            Checksum = true;
+        } else if (strcmp(argv[i], "--lazy") == 0) {
+            Lazy = true;
+        } else if (strcmp(argv[i], "--compressed") == 0) {
+            Data.UseCompression();
+        } else if (strncmp(argv[i], "--pages=", 8) == 0) {
+            if (!ParsePagePolicy(argv[i] + 8, Pages)) {
+                printf("Unknown page policy %s.\n", argv[i] + 8);
+                return EXIT_FAILURE;
+            }
+            PageReport = true;
+        } else if (strcmp(argv[i], "--prefault") == 0) {
+            Prefault = PageReport = true;
+        } else if (strncmp(argv[i], "--shards=", 9) == 0) {
+            Shards = atoi(argv[i] + 9);
+            if (Shards < 1) {
+                printf("Bad worker count %s.\n", argv[i] + 9);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--tune") == 0) {
+            Tune = true;
+        } else {
+            printf("Unknown option %s.\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (Shards > 0 && PageReport) {
+        // The workers filter their own shared mapping, not the paged matrix.
+        printf("--pages and --prefault can not be combined with --shards.\n");
+        return EXIT_FAILURE;
+    }
+    if (Data.IsCompressed() && (PageReport || Shards > 0)) {
+        // Compressed rows are filtered block by block, never in a matrix.
+        printf("--pages, --prefault and --shards can not be combined with --compressed.\n");
+        return EXIT_FAILURE;
+    }
+    Autotune::Load(Tune);
+    Data.UsePages(Pages, Prefault);
+    Data.UseShards(Shards);
+    if (Verbatim) {
+        // Round-trip mode: only the repaired cells are re-formatted.
+        Data.ReadDataMapped(argv[1]);
+        Data.WriteDataVerbatim(Data.FilterData(), argv[2]);
+        return EXIT_SUCCESS;
+    }
+    if (Lazy) {
+        // Index the file, FilterData will then parse it in parallel.
+        auto Start = std::chrono::steady_clock::now();
+        Data.ReadDataLazy(argv[1]);
+        if (Data.RowCount() > 0) Data.GetRow(0);
+        std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+        printf("%d rows indexed, first row after %.2f ms.\n", Data.RowCount(), Elapsed.count());
+    } else {
+        //Assigne the input file path.
+        Data.ReadData(argv[1]);
+    }
+    if (FanOut) {
+        // CSV, binary copy and statistics written side by side.
+        Data.WriteDataFanOut(Data.FilterData(), argv[2], ';', Checksum);
+        return EXIT_SUCCESS;
+    }
+    if (Data.IsCompressed()) {
+        // Report how well the data compressed and the filter throughput.
+        const BlockStore& Packed = Data.GetCompressed();
+        auto Start = std::chrono::steady_clock::now();
+        BlockStore Filtered = Data.FilterCompressedData();
+        std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+        printf("Compression ratio: %.2f (%zu -> %zu bytes).\n",
+               static_cast<double>(Packed.RawBytes()) / Packed.CompressedBytes(),
+               Packed.RawBytes(), Packed.CompressedBytes());
+        printf("Decompress + filter: %.1f MB/s.\n", Packed.RawBytes() / Elapsed.count() / 1e6);
+        Data.WriteData(Filtered, argv[2]);
+        return EXIT_SUCCESS;
+    }
+    if (Data.IsSparse()) {
+        // Mostly zeros: repair and write without building the dense matrix.
+        Data.WriteData(Data.FilterSparseData(), argv[2]);
+        return EXIT_SUCCESS;
+    }
+    if (PageReport) {
+        // Same as below, with the memory system counters of the copy into
+        // the matrix (first touches) and of the filter pass, apart.
+        PerfCounters Copy, Pass;
+        Data.CountFilter(&Copy, &Pass);
+        Array Filtered = Data.FilterData();
+        const std::pair<const char*, PerfCounters*> Phases[] = {{"Copy in", &Copy}, {"Filter", &Pass}};
+        for (const auto& Phase : Phases) {
+            const double Seconds = (Phase.second == &Copy) ? Data.CopySeconds() : Data.FilterSeconds();
+            printf("%s: %.3f s, page faults %llu, dTLB load misses ", Phase.first, Seconds,
+                   static_cast<unsigned long long>(Phase.second->PageFaults()));
+            if (Phase.second->HasTlb()) printf("%llu.\n", static_cast<unsigned long long>(Phase.second->TlbMisses()));
+            else printf("n/a.\n");
+        }
+        Data.WriteData(Filtered, argv[2]);
+        return EXIT_SUCCESS;
+    }
     //use GetData method to retrieve data
     //Write to a file the filtered data
     Data.WriteData(Data.FilterData(), argv[2]);
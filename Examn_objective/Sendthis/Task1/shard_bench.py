@@ -0,0 +1,49 @@
+#!/usr/bin/python
+"""Scaling of Task1App --shards=N with the number of worker processes.
+
+usage: shard_bench.py <Task1App binary> <input csv> [largest worker count, default 8]
+Runs 1, 2, 4, ... workers, prints the sharded filter time and the speedup
+over one worker, and checks every output against the single process one.
+"""
+import filecmp
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def main():
+    binary, data = sys.argv[1], sys.argv[2]
+    largest = int(sys.argv[3]) if len(sys.argv) > 3 else 8
+    folder = tempfile.mkdtemp()
+    try:
+        reference = os.path.join(folder, "single.csv")
+        subprocess.run([binary, data, reference], stdout=subprocess.DEVNULL, check=True)
+        print("%8s %10s %10s %9s %8s" % ("workers", "filter s", "slowest s", "speedup", "output"))
+        base = None
+        workers = 1
+        while workers <= largest:
+            output = os.path.join(folder, "sharded.csv")
+            run = subprocess.run([binary, data, output, "--shards=%d" % workers],
+                                 stdout=subprocess.PIPE, check=True)
+            found = re.search(rb"workers, ([0-9.]+) s \(slowest worker ([0-9.]+) s\)", run.stdout)
+            if found is None:
+                print("no sharded run (matrix not rectangular?)")
+                return 1
+            seconds, slowest = float(found.group(1)), float(found.group(2))
+            base = base or seconds
+            same = filecmp.cmp(reference, output, shallow=False)
+            print("%8d %10.3f %10.3f %8.2fx %8s" % (workers, seconds, slowest, base / seconds,
+                                                   "same" if same else "DIFFERS"))
+            if not same:
+                return 1
+            workers *= 2
+    finally:
+        shutil.rmtree(folder)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
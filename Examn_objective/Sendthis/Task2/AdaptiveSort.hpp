@@ -0,0 +1,179 @@
+// Header file of the adaptive sorting engine - Task2App
+// Author: Salah Eddine Ghamri
+#ifndef ADAPTIVESORT_HPP
+#define ADAPTIVESORT_HPP
+
+// include dependecies =========================================================
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+//==============================================================================
+// The engine sorts a permutation: Order holds element positions and
+// less(a, b) compares the keys of positions a and b. Sorting is stable.
+//
+// Presorted runs (ascending, or strictly descending and reversed) are found
+// in one pass, short runs are extended to MinRun by binary insertion, and
+// runs are merged in powersort order (merge tree close to optimal for the run
+// lengths). Merges gallop: whole blocks that are already in place are found
+// by exponential search instead of one comparison per element.
+// A nearly sorted input is a handful of long runs and costs about n
+// comparisons.
+//==============================================================================
+
+const int MinRun = 32;
+const int MinGallop = 7;
+
+// First position in [First, Last) whose element is greater than Key,
+// searched from First with growing steps.
+template<class Less>
+int* GallopUpper(int* First, int* Last, int Key, Less less) {
+    std::ptrdiff_t n = Last - First, Lo = 0, Hi = 0;
+    while (Hi < n && !less(Key, First[Hi])) { Lo = Hi + 1; Hi = 2 * Hi + 1; }
+    if (Hi > n) Hi = n;
+    return std::upper_bound(First + Lo, First + Hi, Key, less);
+}
+
+// First position in [First, Last) whose element is not less than Key.
+template<class Less>
+int* GallopLower(int* First, int* Last, int Key, Less less) {
+    std::ptrdiff_t n = Last - First, Lo = 0, Hi = 0;
+    while (Hi < n && less(First[Hi], Key)) { Lo = Hi + 1; Hi = 2 * Hi + 1; }
+    if (Hi > n) Hi = n;
+    return std::lower_bound(First + Lo, First + Hi, Key, less);
+}
+
+// Sorts [Begin, End) knowing that [Begin, Sorted) already is.
+template<class Less>
+void BinaryInsertion(int* Begin, int* Sorted, int* End, Less less) {
+    for (; Sorted < End; ++Sorted) {
+        int Key = *Sorted;
+        int* Place = std::upper_bound(Begin, Sorted, Key, less);
+        std::copy_backward(Place, Sorted, Sorted + 1);
+        *Place = Key;
+    }
+}
+
+// Length of the run starting at Begin, made ascending.
+template<class Less>
+int* FindRun(int* Begin, int* End, Less less) {
+    int* Next = Begin + 1;
+    if (Next == End) return End;
+    if (less(*Next, *Begin)) {
+        // Strictly descending (keeps stability when reversed).
+        while (Next + 1 < End && less(*(Next + 1), *Next)) ++Next;
+        std::reverse(Begin, Next + 1);
+    } else {
+        while (Next + 1 < End && !less(*(Next + 1), *Next)) ++Next;
+    }
+    return Next + 1;
+}
+
+// Merges the sorted ranges [Begin, Mid) and [Mid, End).
+template<class Less>
+void MergeRuns(int* Begin, int* Mid, int* End, std::vector<int>& Buffer, Less less) {
+    // Left elements not greater than the first right one are in place, so
+    // are right elements not less than the last left one.
+    Begin = GallopUpper(Begin, Mid, *Mid, less);
+    if (Begin == Mid) return;
+    End = GallopLower(Mid, End, *(Mid - 1), less);
+
+    Buffer.assign(Begin, Mid);
+    int *L = Buffer.data(), *LEnd = L + Buffer.size(), *R = Mid, *Out = Begin;
+    while (L < LEnd && R < End) {
+        int LWins = 0, RWins = 0;
+        // One element at a time until a side keeps winning.
+        while (L < LEnd && R < End && LWins < MinGallop && RWins < MinGallop) {
+            if (less(*R, *L)) { *Out++ = *R++; ++RWins; LWins = 0; }
+            else { *Out++ = *L++; ++LWins; RWins = 0; }
+        }
+        if (L == LEnd || R == End) break;
+        // Then move the winning side by blocks.
+        if (LWins >= MinGallop) {
+            int* Stop = GallopUpper(L, LEnd, *R, less);
+            Out = std::copy(L, Stop, Out);
+            L = Stop;
+        } else {
+            int* Stop = GallopLower(R, End, *L, less);
+            Out = std::copy(R, Stop, Out);
+            R = Stop;
+        }
+    }
+    std::copy(L, LEnd, Out); // what is left of the right run is in place
+}
+
+// Powersort priority of the boundary between the runs [A, B) and [B, C)
+// of an array of n elements: the first bit where their midpoints differ.
+inline int NodePower(std::size_t A, std::size_t B, std::size_t C, std::size_t n) {
+    uint64_t TwoN = 2 * static_cast<uint64_t>(n);
+    uint64_t L = A + B, R = B + C; // doubled midpoints
+    int Power = 0;
+    while (true) {
+        ++Power;
+        if (L >= TwoN) { L -= TwoN; R -= TwoN; }
+        else if (R >= TwoN) break;
+        L <<= 1;
+        R <<= 1;
+    }
+    return Power;
+}
+
+template<class Less>
+void SortIndexAdaptive(std::vector<int>& Order, Less less) {
+    const std::size_t n = Order.size();
+    if (n < 2) return;
+    int* Base = Order.data();
+    int* End = Base + n;
+    struct Run { int* Begin; int* End; int Power; };
+    std::vector<Run> Stack;
+    std::vector<int> Buffer;
+
+    int* Begin = Base;
+    int* RunEnd = FindRun(Begin, End, less);
+    if (RunEnd - Begin < MinRun) {
+        int* Extended = std::min(Begin + MinRun, End);
+        BinaryInsertion(Begin, RunEnd, Extended, less);
+        RunEnd = Extended;
+    }
+    Run Current{Begin, RunEnd, 0};
+    while (Current.End < End) {
+        Begin = Current.End;
+        RunEnd = FindRun(Begin, End, less);
+        if (RunEnd - Begin < MinRun) {
+            int* Extended = std::min(Begin + MinRun, End);
+            BinaryInsertion(Begin, RunEnd, Extended, less);
+            RunEnd = Extended;
+        }
+        int Power = NodePower(Current.Begin - Base, Begin - Base, RunEnd - Base, n);
+        // Runs deeper in the merge tree than the new boundary are finished.
+        while (!Stack.empty() && Stack.back().Power > Power) {
+            MergeRuns(Stack.back().Begin, Current.Begin, Current.End, Buffer, less);
+            Current.Begin = Stack.back().Begin;
+            Stack.pop_back();
+        }
+        Current.Power = Power;
+        Stack.push_back(Current);
+        Current = Run{Begin, RunEnd, 0};
+    }
+    while (!Stack.empty()) {
+        MergeRuns(Stack.back().Begin, Current.Begin, Current.End, Buffer, less);
+        Current.Begin = Stack.back().Begin;
+        Stack.pop_back();
+    }
+}
+
+// Cheap presortedness probe: compares up to Samples adjacent pairs spread
+// over Order. Mostly ascending or mostly descending pairs mean long runs.
+template<class Less>
+bool LooksPresorted(const std::vector<int>& Order, Less less, std::size_t Samples = 1024) {
+    const std::size_t n = Order.size();
+    if (n < 2 * MinRun) return true;
+    if (Samples > n - 1) Samples = n - 1;
+    std::size_t Descents = 0;
+    for (std::size_t s = 0; s < Samples; ++s) {
+        std::size_t i = s * (n - 1) / Samples;
+        Descents += less(Order[i + 1], Order[i]);
+    }
+    return Descents * 8 <= Samples || Descents * 8 >= Samples * 7;
+}
+
+#endif // ifndef ADAPTIVESORT_HPP
@@ -0,0 +1,105 @@
+// Microbenchmarks of the Task2App sorting kernels - Task2Bench
+// Author: Salah Eddine Ghamri
+// Usage: ./Task2Bench [--filter=<name>] [--out=<file>] ..., see MicroBench.hpp
+//==============================================================================
+#include "MicroBench.hpp"
+#include "Myfunctions.hpp"
+#include "AdaptiveSort.hpp"
+#include "KeyDictionary.hpp"
+#include <numeric>
+#include <random>
+//==============================================================================
+
+namespace {
+
+// n keys in order, 1% of them moved back in time.
+IntV NearlySorted(std::size_t n) {
+    std::mt19937 Random(42);
+    IntV Keys(n);
+    for (std::size_t i = 0; i < n; ++i) Keys[i] = 10 * i;
+    for (std::size_t k = 0; k < n / 100; ++k) {
+        std::size_t i = Random() % n;
+        Keys[i] = (i > 500) ? Keys[i] - 5000 : 0;
+    }
+    return Keys;
+}
+
+IntV RandomKeys(std::size_t n) {
+    std::mt19937 Random(42);
+    IntV Keys(n);
+    for (int& Key : Keys) Key = Random() % (1 << 30);
+    return Keys;
+}
+
+StrV Labels(std::size_t n) {
+    StrV Payload(n);
+    for (std::size_t i = 0; i < n; ++i) Payload[i] = std::to_string(i);
+    return Payload;
+}
+
+} // namespace
+
+MICROBENCH_ARGS(SortFunctionOne, 1000, 5000) {
+    IntV Keys = RandomKeys(State.Arg());
+    StrV Payload = Labels(State.Arg());
+    while (State.KeepRunning()) {
+        std::pair<StrV, IntV> Sorted = SortFunctionOne(Payload, Keys, Smaller);
+        MicroBench::DoNotOptimize(Sorted);
+    }
+}
+
+MICROBENCH_ARGS(AdaptiveNearlySorted, 100000, 1000000) {
+    IntV Keys = NearlySorted(State.Arg());
+    StrV Payload = Labels(State.Arg());
+    while (State.KeepRunning()) {
+        std::pair<StrV, IntV> Sorted = SortFunctionAdaptive(Payload, Keys, Smaller);
+        MicroBench::DoNotOptimize(Sorted);
+    }
+}
+
+MICROBENCH_ARGS(AdaptiveRandom, 100000, 1000000) {
+    IntV Keys = RandomKeys(State.Arg());
+    StrV Payload = Labels(State.Arg());
+    while (State.KeepRunning()) {
+        std::pair<StrV, IntV> Sorted = SortFunctionAdaptive(Payload, Keys, Smaller);
+        MicroBench::DoNotOptimize(Sorted);
+    }
+}
+
+// The index engine alone, without moving the payload.
+MICROBENCH_ARGS(SortIndexNearlySorted, 1000000) {
+    IntV Keys = NearlySorted(State.Arg());
+    std::vector<int> Order(Keys.size());
+    while (State.KeepRunning()) {
+        std::iota(Order.begin(), Order.end(), 0);
+        SortIndexAdaptive(Order, [&Keys](int a, int b) { return Keys[a] < Keys[b]; });
+        MicroBench::DoNotOptimize(Order);
+    }
+}
+
+// String keys with Arg distinct values, 200000 keys.
+MICROBENCH_ARGS(EncodedStrings, 16, 4096, 200000) {
+    std::mt19937 Random(42);
+    StrV Keys(200000);
+    for (std::string& Key : Keys) Key = "category-" + std::to_string(Random() % State.Arg());
+    IntV Payload(Keys.size());
+    while (State.KeepRunning()) {
+        std::pair<IntV, StrV> Sorted = SortFunctionEncoded(Payload, Keys, SmallerString);
+        MicroBench::DoNotOptimize(Sorted);
+    }
+}
+
+MICROBENCH_ARGS(RadixSortCodes, 256, 1 << 24) {
+    std::mt19937 Random(42);
+    std::vector<uint32_t> Codes(1000000);
+    for (uint32_t& Code : Codes) Code = Random() % State.Arg();
+    std::vector<int> Order;
+    while (State.KeepRunning()) {
+        RadixSortIndex(Codes, Order);
+        MicroBench::DoNotOptimize(Order);
+    }
+}
+
+int main(int args, char** argv) {
+    return MicroBench::Main(args, argv);
+}
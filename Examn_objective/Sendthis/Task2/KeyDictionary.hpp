@@ -0,0 +1,135 @@
+// Header file of the key dictionary encoding - Task2App
+// Author: Salah Eddine Ghamri
+#ifndef KEYDICTIONARY_HPP
+#define KEYDICTIONARY_HPP
+
+// include dependecies =========================================================
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <cstdint>
+//==============================================================================
+// Order-preserving dictionary encoding: every key is replaced by the rank of
+// its value among the distinct keys, so comparing codes gives the same order
+// as comparing keys and the codes can be radix sorted.
+//==============================================================================
+
+// Open addressing set of key positions, linear probing. Only the first
+// position of every distinct key is stored, with its hash.
+template<class V>
+class KeyTable{
+    const V& Keys;
+    std::vector<int> Slots;
+    std::vector<std::size_t> Hashes;
+    std::size_t Mask;
+ public:
+     KeyTable(const V& keys, std::size_t Expected): Keys(keys) { Reserve(Expected); }
+     std::size_t Capacity() const { return Slots.size(); }
+     // Empties the table, sized for Expected keys at half load.
+     void Reserve(std::size_t Expected) {
+         std::size_t Size = 16;
+         while (Size < 2 * Expected) Size <<= 1;
+         Slots.assign(Size, -1);
+         Hashes.assign(Size, 0);
+         Mask = Size - 1;
+     }
+     // Position of the first key equal to Keys[i], i itself if it is new.
+     int Insert(int i) {
+         std::size_t Hash = std::hash<typename V::value_type>()(Keys[i]);
+         for (std::size_t s = Hash & Mask; ; s = (s + 1) & Mask) {
+             if (Slots[s] < 0) {
+                 Slots[s] = i;
+                 Hashes[s] = Hash;
+                 return i;
+             }
+             if (Hashes[s] == Hash && Keys[Slots[s]] == Keys[i]) return Slots[s];
+         }
+     }
+};
+
+// Sorts Positions with less, one slice per thread (all cores by default)
+// then merging the slices two by two.
+template<class Less>
+void ParallelSort(std::vector<int>& Positions, Less less, unsigned Threads = std::thread::hardware_concurrency()) {
+    if (Threads == 0 || Positions.size() < 8192) Threads = 1;
+    std::vector<std::size_t> Bounds;
+    for (unsigned t = 0; t <= Threads; ++t) Bounds.push_back(Positions.size() * t / Threads);
+    std::vector<std::thread> Workers;
+    for (unsigned t = 0; t < Threads; ++t)
+        Workers.emplace_back([&Positions, &Bounds, less, t]() {
+            std::sort(Positions.begin() + Bounds[t], Positions.begin() + Bounds[t + 1], less);
+        });
+    for (std::thread& Worker : Workers) Worker.join();
+
+    for (std::size_t Width = 1; Width < Threads; Width *= 2) {
+        Workers.clear();
+        for (std::size_t t = 0; t + Width < Threads; t += 2 * Width) {
+            std::size_t Last = std::min<std::size_t>(t + 2 * Width, Threads);
+            Workers.emplace_back([&Positions, &Bounds, less, t, Width, Last]() {
+                std::inplace_merge(Positions.begin() + Bounds[t], Positions.begin() + Bounds[t + Width],
+                                   Positions.begin() + Bounds[Last], less);
+            });
+        }
+        for (std::thread& Worker : Workers) Worker.join();
+    }
+}
+
+// Fills Codes with the rank of every key, returns the number of distinct
+// keys. less must be a strict weak order where equal keys are equivalent.
+// The distinct keys are sorted by Threads threads.
+template<class V, class Less>
+std::size_t EncodeKeys(const V& Keys, Less less, std::vector<uint32_t>& Codes,
+                       unsigned Threads = std::thread::hardware_concurrency()) {
+    const int n = Keys.size();
+    KeyTable<V> Table(Keys, 1024);
+    std::vector<int> Distinct;             // first position of each distinct key
+    std::vector<uint32_t> Id(n);           // index in Distinct of every key
+    std::vector<uint32_t> IdAt(n);         // same, addressed by first position
+    for (int i = 0; i < n; ++i) {
+        int First = Table.Insert(i);
+        if (First == i) {
+            IdAt[i] = Distinct.size();
+            Distinct.push_back(i);
+            if (2 * Distinct.size() >= Table.Capacity()) {
+                // Half full: grow and reinsert the distinct keys.
+                Table.Reserve(2 * Distinct.size());
+                for (int Position : Distinct) Table.Insert(Position);
+            }
+        }
+        Id[i] = IdAt[First];
+    }
+
+    std::vector<int> Sorted = Distinct;
+    ParallelSort(Sorted, [&Keys, less](int a, int b) { return less(Keys[a], Keys[b]); }, Threads);
+    std::vector<uint32_t> Rank(Distinct.size());
+    for (std::size_t r = 0; r < Sorted.size(); ++r) Rank[IdAt[Sorted[r]]] = r;
+
+    Codes.resize(n);
+    for (int i = 0; i < n; ++i) Codes[i] = Rank[Id[i]];
+    return Distinct.size();
+}
+
+// Stable LSD radix sort of the positions 0..n-1 by Codes, Bits bits a pass
+// (1 to 16). Passes above the highest code are skipped (one pass for <= 256
+// keys at 8 bits); wider digits mean fewer passes but bigger counts.
+inline void RadixSortIndex(const std::vector<uint32_t>& Codes, std::vector<int>& Order, int Bits = 8) {
+    const std::size_t n = Codes.size();
+    Bits = std::min(std::max(Bits, 1), 16);
+    const uint32_t Digits = 1u << Bits, Mask = Digits - 1;
+    Order.resize(n);
+    for (std::size_t i = 0; i < n; ++i) Order[i] = i;
+    uint32_t Max = 0;
+    for (uint32_t Code : Codes) Max = std::max(Max, Code);
+    std::vector<int> Next(n);
+    std::vector<std::size_t> Count(Digits + 1);
+    for (int Shift = 0; Shift < 32 && (Max >> Shift) != 0; Shift += Bits) {
+        std::fill(Count.begin(), Count.end(), 0);
+        for (uint32_t Code : Codes) ++Count[((Code >> Shift) & Mask) + 1];
+        for (uint32_t d = 0; d < Digits; ++d) Count[d + 1] += Count[d];
+        for (int i : Order) Next[Count[(Codes[i] >> Shift) & Mask]++] = i;
+        Order.swap(Next);
+    }
+}
+
+#endif // ifndef KEYDICTIONARY_HPP
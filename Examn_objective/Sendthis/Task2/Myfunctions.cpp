@@ -1,6 +1,10 @@
 //Implementation file of sortfunctions
 //Author: Salah Eddine Ghamri
 #include "Myfunctions.hpp"
+#include "AdaptiveSort.hpp"
+#include "KeyDictionary.hpp"
+#include "Tuning.hpp"
+#include <numeric>
 //==============================================================================
 
 // function implementation of SortFunctionOne
@@ -43,6 +47,53 @@ std::pair<V1, V2> SortFunctionOne(V1 Cont1, V2 Cont2, bool (*f)(T, T)){
     }
 }
 
+// function implementation of SortFunctionAdaptive
+template<class V1, class V2, class T>
+std::pair<V1, V2> SortFunctionAdaptive(V1 Cont1, V2 Cont2, bool (*f)(T, T)){
+    // Sorts the positions of Cont2 then moves both containers once.
+    if (Cont1.size() != Cont2.size()){
+        printf("Data containers are not of the same size <!>.\n");
+        throw "Size mismatch error";
+    }
+    std::vector<int> Order(Cont2.size());
+    std::iota(Order.begin(), Order.end(), 0);
+    auto Less = [&Cont2, f](int a, int b) { return (*f)(Cont2[a], Cont2[b]); };
+    if (LooksPresorted(Order, Less))
+        SortIndexAdaptive(Order, Less);
+    else
+        std::stable_sort(Order.begin(), Order.end(), Less);
+
+    V1 SortedCont1 = Cont1;
+    V2 SortedCont2 = Cont2;
+    for (std::size_t i = 0; i < Order.size(); ++i){
+        SortedCont1[i] = Cont1[Order[i]];
+        SortedCont2[i] = Cont2[Order[i]];
+    }
+    return std::pair<V1, V2>(SortedCont1, SortedCont2);
+}
+
+// function implementation of SortFunctionEncoded
+template<class V1, class V2, class T>
+std::pair<V1, V2> SortFunctionEncoded(V1 Cont1, V2 Cont2, bool (*f)(T, T)){
+    // Keys become ranks, ranks are radix sorted, both containers follow.
+    if (Cont1.size() != Cont2.size()){
+        printf("Data containers are not of the same size <!>.\n");
+        throw "Size mismatch error";
+    }
+    std::vector<uint32_t> Codes;
+    EncodeKeys(Cont2, f, Codes, SortThreads());
+    std::vector<int> Order;
+    RadixSortIndex(Codes, Order, RadixBits());
+
+    V1 SortedCont1 = Cont1;
+    V2 SortedCont2 = Cont2;
+    for (std::size_t i = 0; i < Order.size(); ++i){
+        SortedCont1[i] = Cont1[Order[i]];
+        SortedCont2[i] = Cont2[Order[i]];
+    }
+    return std::pair<V1, V2>(SortedCont1, SortedCont2);
+}
+
 // Comparator function
 bool Smaller( int var1, int var2){
     // This is an implementation of " < " operand as example
@@ -50,7 +101,15 @@ bool Smaller( int var1, int var2){
     return (var1 < var2) ? true:false;
 }
 
+bool SmallerString( const std::string& var1, const std::string& var2){
+    // " < " on strings, taken by reference to avoid copies.
+    return var1 < var2;
+}
+
 // To avoid linker errors related to template functions.
 // Add whatever variante enteries here.
 // for large projects we need to create template file instead of this.
 template std::pair<StrV, IntV> SortFunctionOne<StrV, IntV, int>(StrV Cont1, IntV Cont2, bool (*f)(int, int));
+template std::pair<StrV, IntV> SortFunctionAdaptive<StrV, IntV, int>(StrV Cont1, IntV Cont2, bool (*f)(int, int));
+template std::pair<IntV, StrV> SortFunctionAdaptive<IntV, StrV, const std::string&>(IntV Cont1, StrV Cont2, bool (*f)(const std::string&, const std::string&));
+template std::pair<IntV, StrV> SortFunctionEncoded<IntV, StrV, const std::string&>(IntV Cont1, StrV Cont2, bool (*f)(const std::string&, const std::string&));
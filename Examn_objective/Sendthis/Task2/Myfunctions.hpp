@@ -15,6 +15,19 @@ using StrV = std::vector<std::string>;
 //functions definitions
 template<class V1, class V2, class T>
 std::pair<V1, V2> SortFunctionOne(V1 Cont1, V2 Cont2, bool (*f)(T, T));
+// Same inputs and outputs as SortFunctionOne, but stable (see
+// AdaptiveSort.hpp): SortFunctionOne is a selection sort and is not, so
+// the Cont1 order of equal keys can differ between the two. Presorted
+// Cont2 inputs are merged run by run, others go to the general sorter.
+template<class V1, class V2, class T>
+std::pair<V1, V2> SortFunctionAdaptive(V1 Cont1, V2 Cont2, bool (*f)(T, T));
+// Same result as SortFunctionAdaptive (stable too), for keys with few
+// distinct values (strings): the keys are dictionary encoded into 32-bit
+// ranks (KeyDictionary.hpp) which are radix sorted, so f only compares the
+// distinct keys.
+template<class V1, class V2, class T>
+std::pair<V1, V2> SortFunctionEncoded(V1 Cont1, V2 Cont2, bool (*f)(T, T));
 bool Smaller( int var1, int var2);
+bool SmallerString( const std::string& var1, const std::string& var2);
 
 #endif // ifndef  MYFUNCTIONS_HPP
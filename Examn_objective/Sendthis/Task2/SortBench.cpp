@@ -0,0 +1,76 @@
+//Implementation file of the sorting benchmarks
+//Author: Salah Eddine Ghamri
+#include "SortBench.hpp"
+#include "Myfunctions.hpp"
+#include "Metrics.hpp"
+#include <chrono>
+#include <random>
+//==============================================================================
+
+namespace {
+
+// SortFunctionOne is quadratic, above this it would take minutes.
+const std::size_t QuadraticLimit = 20000;
+
+// Times one sort of Keys keys, also shown live by metrics-top.
+template<class F>
+double Seconds(std::size_t Keys, F Work) {
+    static Metrics::Counter Sorted("task2.keys_sorted");
+    static Metrics::Gauge Last("task2.last_sort_s");
+    auto Start = std::chrono::steady_clock::now();
+    Work();
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+    Sorted.Add(Keys);
+    Last.Set(Elapsed.count());
+    return Elapsed.count();
+}
+
+void TimeCoSorts(const char* Name, const StrV& Payload, const IntV& Keys) {
+    printf("%-14s", Name);
+    if (Keys.size() <= QuadraticLimit)
+        printf(" SortFunctionOne %9.4f s", Seconds(Keys.size(), [&]() { SortFunctionOne(Payload, Keys, Smaller); }));
+    else
+        printf(" SortFunctionOne %11s", "skipped");
+    printf("  SortFunctionAdaptive %9.4f s\n",
+           Seconds(Keys.size(), [&]() { SortFunctionAdaptive(Payload, Keys, Smaller); }));
+}
+
+} // namespace
+
+void BenchPresorted(std::size_t n) {
+    std::mt19937 Random(42);
+    StrV Payload(n);
+    IntV Keys(n);
+    for (std::size_t i = 0; i < n; ++i) Payload[i] = std::to_string(i);
+
+    // Timestamps appended in order, a few arrive late.
+    for (std::size_t i = 0; i < n; ++i) Keys[i] = 10 * i;
+    std::uniform_int_distribution<std::size_t> Position(0, n - 1);
+    for (std::size_t k = 0; k < n / 100; ++k) {
+        std::size_t i = Position(Random);
+        Keys[i] = (i > 500) ? Keys[i] - 5000 : 0;
+    }
+    printf("%zu keys:\n", n);
+    TimeCoSorts("nearly sorted", Payload, Keys);
+
+    std::uniform_int_distribution<int> Value(0, 1 << 30);
+    for (int& Key : Keys) Key = Value(Random);
+    TimeCoSorts("random", Payload, Keys);
+}
+
+void BenchCardinality(std::size_t n) {
+    std::mt19937 Random(42);
+    IntV Payload(n);
+    StrV Keys(n);
+    for (std::size_t i = 0; i < n; ++i) Payload[i] = i;
+    printf("%zu string keys:\n", n);
+    for (std::size_t Distinct : {4ul, 256ul, 65536ul, n}) {
+        std::uniform_int_distribution<std::size_t> Value(0, Distinct - 1);
+        for (std::string& Key : Keys) Key = "category-" + std::to_string(Value(Random));
+        std::pair<IntV, StrV> Direct, Encoded;
+        double DirectTime = Seconds(Keys.size(), [&]() { Direct = SortFunctionAdaptive(Payload, Keys, SmallerString); });
+        double EncodedTime = Seconds(Keys.size(), [&]() { Encoded = SortFunctionEncoded(Payload, Keys, SmallerString); });
+        printf("%9zu distinct  strings %8.4f s  codes %8.4f s  %s\n", Distinct, DirectTime, EncodedTime,
+               (Direct == Encoded) ? "same order" : "ORDER DIFFERS");
+    }
+}
@@ -0,0 +1,19 @@
+// Header file of the sorting benchmarks - Task2App
+// Author: Salah Eddine Ghamri
+#ifndef SORTBENCH_HPP
+#define SORTBENCH_HPP
+
+// include dependecies =========================================================
+#include <cstddef>
+//==============================================================================
+
+// Times the co-sorts on n keys, nearly sorted (appended timestamps with 1%
+// stragglers) and random. SortFunctionOne only runs for small n.
+void BenchPresorted(std::size_t n);
+
+// Times string keyed co-sorts on n keys for growing numbers of distinct
+// keys: comparing strings (SortFunctionAdaptive) against dictionary codes
+// (SortFunctionEncoded). Both results must match.
+void BenchCardinality(std::size_t n);
+
+#endif // ifndef  SORTBENCH_HPP
@@ -0,0 +1,53 @@
+// Implementation file of the tuned parameters - Task2App
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Tuning.hpp"
+#include "KeyDictionary.hpp"
+#include <chrono>
+#include <random>
+//==============================================================================
+
+namespace {
+
+// Calibration inputs: a million codes / keys, a run takes milliseconds.
+const std::size_t SampleKeys = 1 << 20;
+
+template<class F>
+double Seconds(F Work) {
+    auto Start = std::chrono::steady_clock::now();
+    Work();
+    std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+const std::vector<uint32_t>& SampleCodes() {
+    // As many distinct codes as keys, the worst case for the radix sort.
+    static std::vector<uint32_t> Codes;
+    if (!Codes.empty()) return Codes;
+    std::mt19937 Random(42);
+    Codes.resize(SampleKeys);
+    for (uint32_t& Code : Codes) Code = Random() % SampleKeys;
+    return Codes;
+}
+
+double TimeRadix(long Bits) {
+    std::vector<int> Order;
+    return Seconds([&]() { RadixSortIndex(SampleCodes(), Order, Bits); });
+}
+
+double TimeSortThreads(long Threads) {
+    const std::vector<uint32_t>& Codes = SampleCodes();
+    std::vector<int> Positions(Codes.size());
+    for (std::size_t i = 0; i < Positions.size(); ++i) Positions[i] = i;
+    return Seconds([&]() {
+        ParallelSort(Positions, [&Codes](int a, int b) { return Codes[a] < Codes[b]; }, Threads);
+    });
+}
+
+} // namespace
+
+void RegisterTuning() {
+    Autotune::Register("sort.radix_bits", 8, {8, 11, 16}, TimeRadix);
+    Autotune::Register("sort.threads", std::max(1u, std::thread::hardware_concurrency()),
+                       Autotune::ThreadCandidates(), TimeSortThreads);
+}
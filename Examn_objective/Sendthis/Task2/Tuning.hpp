@@ -0,0 +1,31 @@
+// Header file of the tuned parameters - Task2App
+// Author: Salah Eddine Ghamri
+#ifndef TUNING_HPP
+#define TUNING_HPP
+
+//==============================================================================
+// Included dependencies:
+#include "Autotune.hpp"
+#include <algorithm>
+#include <thread>
+//==============================================================================
+// Parameters of the encoded sort picked per host by Autotune (see
+// Autotune.hpp); until Load has run they are the defaults.
+//==============================================================================
+
+// Digit width of RadixSortIndex, default 8 bits.
+inline int RadixBits() {
+    return std::min(16L, std::max(1L, Autotune::Get("sort.radix_bits", 8)));
+}
+
+// Threads sorting the distinct keys in EncodeKeys, default one per core.
+inline unsigned SortThreads() {
+    const long Cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1L, Autotune::Get("sort.threads", Cores));
+}
+
+// Registers the calibration runs of the parameters above, call it before
+// Autotune::Load.
+void RegisterTuning();
+
+#endif // ifndef TUNING_HPP
@@ -12,17 +12,35 @@
 //                  The function will not modify the original data. So it will
 //                  return a zipped form of data that needs more processing
 //                  to diplay the requested results.
+//                  "Task2App bench [n]" times the sorting functions instead,
+//                  "Task2App bench-strings [n]" the string keyed ones.
+//                  "Task2App tune" calibrates the encoded sort of this
+//                  host and saves it for later runs (see Autotune.hpp).
 # C++_version     : C++14
 # //TODO          : ...
 # ==============================================================================
 */
 #include "Myfunctions.hpp"
+#include "SortBench.hpp"
+#include "Tuning.hpp"
+#include <cstring>
 
 //Iterate vectors
 IntV IntegerVector = {0, 4, 2, 8, 4};
 StrV StringVector = {"A", "B", "C", "D", "E"};
 
-int main(){
+int main(int args, char** argv){
+    RegisterTuning();
+    if (args > 1 && strcmp(argv[1], "tune") == 0) return Autotune::Load(true) ? EXIT_SUCCESS : EXIT_FAILURE;
+    Autotune::Load(false);
+    if (args > 1 && strcmp(argv[1], "bench") == 0) {
+        BenchPresorted(args > 2 ? std::stoul(argv[2]) : 1000000);
+        return EXIT_SUCCESS;
+    }
+    if (args > 1 && strcmp(argv[1], "bench-strings") == 0) {
+        BenchCardinality(args > 2 ? std::stoul(argv[2]) : 1000000);
+        return EXIT_SUCCESS;
+    }
     // We assume using STL Vectors
     // STL lists do not support random access, mixing Vector - list enteries
     // demands profound reflexion - or at least overloading operator[]
@@ -0,0 +1,84 @@
+// Microbenchmarks of the File_IO kernels - FileBench
+// Author: Salah Eddine Ghamri
+// Usage: ./FileBench [--filter=<name>] [--out=<file>] ..., see MicroBench.hpp
+//==============================================================================
+#include "MicroBench.hpp"
+#include "TextSearch.hpp"
+#include "WordCount.hpp"
+#include "NumberWords.hpp"
+#include <random>
+//==============================================================================
+
+namespace {
+
+const std::string Marker = "give it's multiplcation with the following number:";
+
+// 16 MB of log-like lines, the marker once every 1000 lines.
+const std::string& LogText() {
+    static std::string Text;
+    if (!Text.empty()) return Text;
+    std::mt19937 Random(42);
+    for (int Line = 0; Text.size() < (16u << 20); ++Line) {
+        Text += "2018-11-16 12:00:" + std::to_string(Line % 60) + " worker " + std::to_string(Random() % 64)
+              + " processed record " + std::to_string(Random()) + "\n";
+        if (Line % 1000 == 0) Text += Marker + "\n5\n";
+    }
+    return Text;
+}
+
+} // namespace
+
+MICROBENCH(FindMarker) {
+    const std::string& Text = LogText();
+    std::vector<Match> Found;
+    while (State.KeepRunning()) {
+        Found.clear();
+        FindPattern(Text.data(), Text.size(), Text.data() + Text.size(), Marker, 0, Found);
+        MicroBench::DoNotOptimize(Found);
+    }
+}
+
+MICROBENCH(FindRareByte) {
+    const std::string& Text = LogText();
+    std::vector<Match> Found;
+    while (State.KeepRunning()) {
+        Found.clear();
+        FindPattern(Text.data(), Text.size(), Text.data() + Text.size(), "multiplcation", 0, Found);
+        MicroBench::DoNotOptimize(Found);
+    }
+}
+
+MICROBENCH_ARGS(AhoCorasick, 2, 16, 256) {
+    const std::string& Text = LogText();
+    std::vector<std::string> Patterns = {Marker, "worker 63 processed"};
+    for (int p = 2; p < State.Arg(); ++p) Patterns.push_back("record " + std::to_string(1000000 + p * 7919));
+    MultiPattern Automaton(Patterns);
+    std::vector<Match> Found;
+    while (State.KeepRunning()) {
+        Found.clear();
+        Automaton.Find(Text.data(), Text.data(), Text.size(), Text.data() + Text.size(), 0, Found);
+        MicroBench::DoNotOptimize(Found);
+    }
+}
+
+MICROBENCH(TokenizeLog) {
+    const std::string& Text = LogText();
+    while (State.KeepRunning()) {
+        WordTable Counts;
+        Tokenize(Text.data(), Text.data() + Text.size(), Counts);
+        MicroBench::DoNotOptimize(Counts);
+    }
+}
+
+MICROBENCH(SpellNumbers) {
+    std::mt19937_64 Random(42);
+    std::vector<int64_t> Values(4096);
+    for (int64_t& Value : Values) Value = static_cast<int64_t>(Random() >> (Random() % 64));
+    std::vector<char> Out(Values.size() * MaxWordsLength);
+    while (State.KeepRunning())
+        MicroBench::DoNotOptimize(NumbersToWords(Values.data(), Values.size(), Out.data()));
+}
+
+int main(int args, char** argv) {
+    return MicroBench::Main(args, argv);
+}
@@ -0,0 +1,115 @@
+// Implementation file of NumberWords - File_IO
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "NumberWords.hpp"
+#include <cstring>
+//==============================================================================
+
+namespace {
+
+constexpr const char* Ones[20] = {
+    "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
+    "ten", "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen",
+    "seventeen", "eighteen", "nineteen"
+};
+constexpr const char* Tens[10] = {
+    "", "", "twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty", "ninety"
+};
+
+// Every table entry is copied Width bytes at once, then the output moves by
+// its real length; the longest entry ("seven hundred seventy-seven") is 27.
+const std::size_t Width = 32;
+
+// Words of 0..999 (and the scale names), built by the compiler.
+struct SpelledTable{
+    char Text[1000][Width];
+    unsigned char Length[1000];
+
+    constexpr std::size_t Append(int n, std::size_t At, const char* Word) {
+        while (*Word) Text[n][At++] = *Word++;
+        return At;
+    }
+    constexpr SpelledTable(): Text(), Length() {
+        for (int n = 0; n < 1000; ++n) {
+            std::size_t At = 0;
+            int Hundreds = n / 100, Rest = n % 100;
+            if (Hundreds) {
+                At = Append(n, At, Ones[Hundreds]);
+                At = Append(n, At, " hundred");
+                if (Rest) At = Append(n, At, " ");
+            }
+            if (Rest >= 20) {
+                At = Append(n, At, Tens[Rest / 10]);
+                if (Rest % 10) {
+                    At = Append(n, At, "-");
+                    At = Append(n, At, Ones[Rest % 10]);
+                }
+            } else if (Rest || !Hundreds) {
+                At = Append(n, At, Ones[Rest]);
+            }
+            Length[n] = static_cast<unsigned char>(At);
+        }
+    }
+};
+
+struct ScaleTable{
+    char Text[7][Width];
+    unsigned char Length[7];
+    constexpr ScaleTable(): Text(), Length() {
+        const char* Names[7] = {
+            "", " thousand", " million", " billion", " trillion", " quadrillion", " quintillion"
+        };
+        for (int s = 0; s < 7; ++s) {
+            std::size_t At = 0;
+            for (const char* c = Names[s]; *c; ++c) Text[s][At++] = *c;
+            Length[s] = static_cast<unsigned char>(At);
+        }
+    }
+};
+
+constexpr SpelledTable Words;
+constexpr ScaleTable Scales;
+static_assert(Words.Length[777] == 27, "longest entry must fit Width");
+
+} // namespace
+
+std::size_t UnsignedToWords(uint64_t Value, char* Out) {
+    if (Value == 0) {
+        std::memcpy(Out, Words.Text[0], Width);
+        return Words.Length[0];
+    }
+    // Groups of three digits, lowest first (2^64 has seven).
+    unsigned Groups[7];
+    int Count = 0;
+    while (Value) {
+        Groups[Count++] = static_cast<unsigned>(Value % 1000);
+        Value /= 1000;
+    }
+    char* At = Out;
+    for (int g = Count - 1; g >= 0; --g) {
+        unsigned n = Groups[g];
+        if (n == 0) continue;
+        if (At != Out) *At++ = ' ';
+        std::memcpy(At, Words.Text[n], Width);
+        At += Words.Length[n];
+        std::memcpy(At, Scales.Text[g], Width);
+        At += Scales.Length[g];
+    }
+    return At - Out;
+}
+
+std::size_t NumberToWords(int64_t Value, char* Out) {
+    if (Value >= 0) return UnsignedToWords(static_cast<uint64_t>(Value), Out);
+    std::memcpy(Out, "minus ", 6);
+    // Negating in unsigned keeps INT64_MIN right.
+    return 6 + UnsignedToWords(0 - static_cast<uint64_t>(Value), Out + 6);
+}
+
+std::size_t NumbersToWords(const int64_t* Values, std::size_t Count, char* Out, char Separator) {
+    char* At = Out;
+    for (std::size_t i = 0; i < Count; ++i) {
+        At += NumberToWords(Values[i], At);
+        *At++ = Separator;
+    }
+    return At - Out;
+}
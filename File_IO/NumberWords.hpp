@@ -0,0 +1,32 @@
+// Header file of NumberWords - File_IO
+// Author: Salah Eddine Ghamri
+#ifndef NUMBERWORDS_HPP
+#define NUMBERWORDS_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <cstddef>
+#include <cstdint>
+//==============================================================================
+
+// English words of 64-bit integers, short scale:
+//   1234567 -> "one million two hundred thirty-four thousand five hundred sixty-seven"
+//   -40     -> "minus forty"
+// The words of 0..999 come from a table built at compile time, a number is
+// at most seven table copies plus the scale names. Nothing is allocated,
+// the words go to a caller buffer and are not terminated.
+
+// Room a caller buffer needs for one number: the longest spelling plus the
+// slack the fixed width copies may write past it.
+const std::size_t MaxWordsLength = 320;
+
+// Returns the number of bytes written to Out.
+std::size_t UnsignedToWords(uint64_t Value, char* Out);
+std::size_t NumberToWords(int64_t Value, char* Out);
+
+// Batch: the words of Count values, each followed by Separator. Out needs
+// Count * MaxWordsLength bytes (less in practice). Returns bytes written.
+std::size_t NumbersToWords(const int64_t* Values, std::size_t Count, char* Out,
+                           char Separator = '\n');
+
+#endif // ifndef NUMBERWORDS_HPP
@@ -0,0 +1,136 @@
+// Implementation file of the follow mode - File_IO
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "TailFollow.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+//==============================================================================
+
+namespace {
+
+// True when Line is a whole integer: optional sign then digits.
+bool ParseOperand(const std::string& Line, long long& Value) {
+    std::size_t i = (!Line.empty() && (Line[0] == '-' || Line[0] == '+')) ? 1 : 0;
+    if (i == Line.size()) return false;
+    for (std::size_t k = i; k < Line.size(); ++k)
+        if (Line[k] < '0' || Line[k] > '9') return false;
+    errno = 0;
+    Value = strtoll(Line.c_str(), nullptr, 10);
+    return errno == 0;
+}
+
+} // namespace
+
+Follower::Follower() {
+    Notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    Wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+Follower::~Follower() {
+    for (Followed& F : Files) close(F.Fd);
+    if (Notify >= 0) close(Notify);
+    if (Wake >= 0) close(Wake);
+}
+
+bool Follower::Add(const std::string& Path, bool FromEnd) {
+    if (Notify < 0 || Wake < 0) return false;
+    int Fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (Fd < 0) return false;
+    int Watch = inotify_add_watch(Notify, Path.c_str(), IN_MODIFY);
+    if (Watch < 0) {
+        close(Fd);
+        return false;
+    }
+    off_t Start = FromEnd ? lseek(Fd, 0, SEEK_END) : 0;
+    Files.push_back(Followed{Path, Fd, Watch, Start, std::string(), false, 0});
+    return true;
+}
+
+void Follower::OnLine(int f, const std::string& Line) {
+    Followed& F = Files[f];
+    long long Value;
+    if (!ParseOperand(Line, Value)) return;
+    if (!F.HasOperand) {
+        F.Operand = Value;
+        F.HasOperand = true;
+        return;
+    }
+    F.HasOperand = false;
+    // The file is not ours to trust: a product past 64 bits is flagged.
+    long long Result;
+    const bool Overflow = __builtin_mul_overflow(F.Operand, Value, &Result);
+    // Our own line comes back through inotify and is skipped: it ends with '.'.
+    std::string Text = Overflow ? "overflow.\n" : std::to_string(Result) + ".\n";
+    int Out = open(F.Path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (Out < 0) return;
+    ssize_t Written = write(Out, Text.data(), Text.size());
+    close(Out);
+    if (Written == static_cast<ssize_t>(Text.size()) && !Overflow && OnResult) OnResult(f, Result);
+}
+
+void Follower::ReadNew(int f) {
+    struct stat Info;
+    if (fstat(Files[f].Fd, &Info) != 0) return;
+    if (Info.st_size < Files[f].Offset) {
+        // Truncated: start over.
+        Files[f].Offset = 0;
+        Files[f].Partial.clear();
+        Files[f].HasOperand = false;
+    }
+    char Buffer[1 << 16];
+    while (true) {
+        ssize_t Got = pread(Files[f].Fd, Buffer, sizeof(Buffer), Files[f].Offset);
+        if (Got <= 0) break;
+        Files[f].Offset += Got;
+        std::size_t Begin = 0;
+        for (ssize_t i = 0; i < Got; ++i) {
+            if (Buffer[i] != '\n') continue;
+            Files[f].Partial.append(Buffer + Begin, i - Begin);
+            std::string Line;
+            Line.swap(Files[f].Partial);
+            if (!Line.empty() && Line.back() == '\r') Line.pop_back();
+            OnLine(f, Line);
+            Begin = i + 1;
+        }
+        Files[f].Partial.append(Buffer + Begin, Got - Begin);
+    }
+}
+
+void Follower::Run() {
+    // What is already there first, then one read per batch of events.
+    for (std::size_t f = 0; f < Files.size(); ++f) ReadNew(f);
+    pollfd Waiting[2] = {{Notify, POLLIN, 0}, {Wake, POLLIN, 0}};
+    alignas(inotify_event) char Events[4096];
+    while (true) {
+        if (poll(Waiting, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (Waiting[1].revents & POLLIN) return;
+        std::vector<bool> Changed(Files.size(), false);
+        ssize_t Got;
+        while ((Got = read(Notify, Events, sizeof(Events))) > 0) {
+            for (char* e = Events; e < Events + Got; ) {
+                const inotify_event* Event = reinterpret_cast<const inotify_event*>(e);
+                // On a queue overflow events were lost: read every file.
+                const bool Lost = (Event->mask & IN_Q_OVERFLOW) != 0;
+                for (std::size_t f = 0; f < Files.size(); ++f)
+                    if (Lost || Files[f].Watch == Event->wd) Changed[f] = true;
+                e += sizeof(inotify_event) + Event->len;
+            }
+        }
+        for (std::size_t f = 0; f < Files.size(); ++f)
+            if (Changed[f]) ReadNew(f);
+    }
+}
+
+void Follower::Stop() {
+    uint64_t One = 1;
+    if (write(Wake, &One, sizeof(One)) < 0) return;
+}
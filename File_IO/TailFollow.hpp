@@ -0,0 +1,50 @@
+// Header file of the follow mode - File_IO
+// Author: Salah Eddine Ghamri
+#ifndef TAILFOLLOW_HPP
+#define TAILFOLLOW_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <vector>
+#include <functional>
+#include <sys/types.h>
+//==============================================================================
+
+// Growing text files of operands, like The_file.txt: every line holding an
+// integer is an operand, each two operands give their product, appended as
+// "<product>.\n" (the format TxtfileIo writes), or "overflow.\n" when the
+// product does not fit 64 bits. Other lines, results included, are skipped.
+//
+// Follower watches the files with inotify and sleeps in poll() between
+// changes: only the bytes appended since the last read offset are read, a
+// partial last line waits for its end. A file shorter than the offset was
+// truncated and is read again from the start.
+class Follower{
+    struct Followed{
+        std::string Path;
+        int Fd, Watch;
+        off_t Offset;
+        std::string Partial;
+        bool HasOperand;
+        long long Operand;
+    };
+    std::vector<Followed> Files;
+    int Notify, Wake;
+    void ReadNew(int f);
+    void OnLine(int f, const std::string& Line);
+ public:
+     // Called after a result was appended: file index and product.
+     std::function<void(int, long long)> OnResult;
+     Follower();
+     Follower(const Follower&) = delete;
+     Follower& operator=(const Follower&) = delete;
+     ~Follower();
+     // FromEnd: only what is appended from now on is processed.
+     bool Add(const std::string& Path, bool FromEnd = false);
+     // Processes the files until Stop is called (from any thread).
+     void Run();
+     void Stop();
+};
+
+#endif // ifndef TAILFOLLOW_HPP
@@ -0,0 +1,159 @@
+// Implementation file of the text search engine - File_IO
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "TextSearch.hpp"
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <thread>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+//==============================================================================
+
+void FindPattern(const char* Begin, std::size_t Size, const char* Limit, const std::string& Pattern,
+                 std::size_t Base, std::vector<Match>& Out) {
+    const std::size_t m = Pattern.size();
+    if (m == 0) return;
+    const char* Text = Begin;
+    const char* Last = std::min(Begin + Size, Limit - m + 1); // last start + 1
+    if (Last <= Text) return;
+    const char First = Pattern[0], End = Pattern[m - 1];
+    std::size_t i = 0;
+    const std::size_t Starts = Last - Text;
+#ifdef __SSE2__
+    // Positions i..i+15 are candidates when both their first and last bytes
+    // match; the loads of the last bytes stay inside the text.
+    const __m128i FirstByte = _mm_set1_epi8(First), LastByte = _mm_set1_epi8(End);
+    for (; i + 16 <= Starts; i += 16) {
+        __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Text + i));
+        __m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Text + i + m - 1));
+        unsigned Mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(A, FirstByte),
+                                                        _mm_cmpeq_epi8(B, LastByte)));
+        while (Mask != 0) {
+            unsigned Bit = __builtin_ctz(Mask);
+            if (m <= 2 || memcmp(Text + i + Bit + 1, Pattern.data() + 1, m - 2) == 0)
+                Out.push_back(Match{Base + i + Bit, 0});
+            Mask &= Mask - 1;
+        }
+    }
+#endif
+    for (; i < Starts; ++i)
+        if (Text[i] == First && Text[i + m - 1] == End && memcmp(Text + i, Pattern.data(), m) == 0)
+            Out.push_back(Match{Base + i, 0});
+}
+
+MultiPattern::MultiPattern(const std::vector<std::string>& Patterns): Starts(256, false), Longest(0) {
+    // Trie first (-1 = no edge), then failure links breadth first, which
+    // also completes the missing edges into a full table.
+    Next.assign(256, -1);
+    std::vector<std::vector<int> > Ending(1);
+    for (std::size_t p = 0; p < Patterns.size(); ++p) {
+        Lengths.push_back(Patterns[p].size());
+        if (Patterns[p].empty()) continue;
+        Longest = std::max(Longest, Patterns[p].size());
+        int State = 0;
+        for (unsigned char c : Patterns[p]) {
+            if (Next[State * 256 + c] < 0) {
+                Next[State * 256 + c] = Ending.size();
+                Next.resize(Next.size() + 256, -1);
+                Ending.emplace_back();
+            }
+            State = Next[State * 256 + c];
+        }
+        Ending[State].push_back(p);
+    }
+
+    std::vector<int> Fail(Ending.size(), 0);
+    std::queue<int> Pending;
+    for (int c = 0; c < 256; ++c) {
+        int& Child = Next[c];
+        if (Child < 0) Child = 0;
+        else Pending.push(Child);
+    }
+    while (!Pending.empty()) {
+        int State = Pending.front();
+        Pending.pop();
+        // Patterns ending at the failure state also end here.
+        Ending[State].insert(Ending[State].end(), Ending[Fail[State]].begin(), Ending[Fail[State]].end());
+        for (int c = 0; c < 256; ++c) {
+            int& Child = Next[State * 256 + c];
+            int Fallback = Next[Fail[State] * 256 + c];
+            if (Child < 0) {
+                Child = Fallback;
+            } else {
+                Fail[Child] = Fallback;
+                Pending.push(Child);
+            }
+        }
+    }
+    for (const std::vector<int>& Patterns : Ending) {
+        OutputBegin.push_back(Outputs.size());
+        Outputs.insert(Outputs.end(), Patterns.begin(), Patterns.end());
+    }
+    OutputBegin.push_back(Outputs.size());
+    // Entries become row offsets (State * 256), bit 0 set when patterns end
+    // in the target state: the scan loop needs no multiply and no extra load.
+    for (int32_t& Entry : Next)
+        Entry = (Entry << 8) | (Ending[Entry].empty() ? 0 : 1);
+    for (const std::string& Pattern : Patterns)
+        if (!Pattern.empty()) Starts[static_cast<unsigned char>(Pattern[0])] = true;
+}
+
+void MultiPattern::Find(const char* From, const char* Begin, std::size_t Size, const char* Limit,
+                        std::size_t Base, std::vector<Match>& Out) const {
+    if (Longest == 0) return;
+    const char* Scan = (Begin - From >= static_cast<std::ptrdiff_t>(Longest - 1)) ? Begin - (Longest - 1) : From;
+    const char* Stop = std::min(Begin + Size + Longest - 1, Limit);
+    int32_t Row = 0;
+    for (const char* c = Scan; c < Stop; ++c) {
+        // In the root, bytes that start no pattern keep us there.
+        if (Row == 0) {
+            while (c < Stop && !Starts[static_cast<unsigned char>(*c)]) ++c;
+            if (c == Stop) break;
+        }
+        int32_t Entry = Next[Row + static_cast<unsigned char>(*c)];
+        Row = Entry & ~1;
+        if ((Entry & 1) == 0) continue;
+        const int State = Row >> 8;
+        for (int o = OutputBegin[State]; o < OutputBegin[State + 1]; ++o) {
+            const char* Start = c + 1 - Lengths[Outputs[o]];
+            if (Start >= Begin && Start < Begin + Size)
+                Out.push_back(Match{Base + (Start - Begin), Outputs[o]});
+        }
+    }
+}
+
+std::vector<Match> SearchText(const char* Data, std::size_t Size,
+                              const std::vector<std::string>& Patterns, unsigned Threads) {
+    std::vector<std::string> Used;
+    std::vector<int> Index;
+    for (std::size_t p = 0; p < Patterns.size(); ++p)
+        if (!Patterns[p].empty()) { Used.push_back(Patterns[p]); Index.push_back(p); }
+    std::vector<Match> All;
+    if (Used.empty() || Size == 0) return All;
+    if (Threads == 0) Threads = 1;
+    // Small inputs are not worth a thread.
+    if (Size < (std::size_t(1) << 20)) Threads = 1;
+
+    MultiPattern Automaton(Used.size() > 1 ? Used : std::vector<std::string>());
+    std::vector<std::vector<Match> > Found(Threads);
+    std::vector<std::thread> Workers;
+    for (unsigned t = 0; t < Threads; ++t) {
+        Workers.emplace_back([&, t]() {
+            std::size_t First = Size * t / Threads, Last = Size * (t + 1) / Threads;
+            if (Used.size() == 1)
+                FindPattern(Data + First, Last - First, Data + Size, Used[0], First, Found[t]);
+            else
+                Automaton.Find(Data, Data + First, Last - First, Data + Size, First, Found[t]);
+        });
+    }
+    for (std::thread& Worker : Workers) Worker.join();
+    for (std::vector<Match>& Part : Found) {
+        // Chunks are in order, only the automaton's matches need sorting.
+        if (Used.size() > 1) std::sort(Part.begin(), Part.end());
+        for (Match& M : Part) M.Pattern = Index[M.Pattern];
+        All.insert(All.end(), Part.begin(), Part.end());
+    }
+    return All;
+}
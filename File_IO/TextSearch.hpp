@@ -0,0 +1,55 @@
+// Header file of the text search engine - File_IO
+// Author: Salah Eddine Ghamri
+#ifndef TEXTSEARCH_HPP
+#define TEXTSEARCH_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+//==============================================================================
+
+// One occurrence: byte offset of its first character and pattern index.
+struct Match{
+    std::size_t Offset;
+    int Pattern;
+    bool operator<(const Match& Other) const {
+        return Offset < Other.Offset || (Offset == Other.Offset && Pattern < Other.Pattern);
+    }
+};
+
+// Appends the offset + Base of every occurrence (overlapping ones too) of
+// Pattern starting in [Begin, Begin + Size). Up to Pattern.size() - 1 bytes
+// after the range are read, Limit is the end of the readable text.
+// Candidates are found 16 positions at a time by comparing the first and the
+// last byte of the pattern (SSE2), then checked with memcmp.
+void FindPattern(const char* Begin, std::size_t Size, const char* Limit, const std::string& Pattern,
+                 std::size_t Base, std::vector<Match>& Out);
+
+// Aho-Corasick automaton for many patterns, as a full transition table:
+// one lookup per byte whatever the number of patterns.
+class MultiPattern{
+    std::vector<int32_t> Next;      // 256 entries per state
+    std::vector<bool> Starts;       // first bytes of the patterns
+    std::vector<int> OutputBegin;   // patterns ending in a state, in Outputs
+    std::vector<int> Outputs;
+    std::vector<std::size_t> Lengths;
+    std::size_t Longest;
+ public:
+     explicit MultiPattern(const std::vector<std::string>& Patterns);
+     std::size_t LongestPattern() const { return Longest; }
+     // Occurrences starting in [Begin, Begin + Size), see FindPattern. The
+     // scan starts LongestPattern() - 1 bytes before Begin when From allows.
+     void Find(const char* From, const char* Begin, std::size_t Size, const char* Limit,
+               std::size_t Base, std::vector<Match>& Out) const;
+};
+
+// Every occurrence of the patterns in Data, sorted by offset. The text is cut
+// in one chunk per thread; one pattern uses FindPattern, several use the
+// automaton. Empty patterns are ignored.
+std::vector<Match> SearchText(const char* Data, std::size_t Size,
+                              const std::vector<std::string>& Patterns, unsigned Threads);
+
+#endif // ifndef TEXTSEARCH_HPP
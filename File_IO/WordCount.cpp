@@ -0,0 +1,167 @@
+// Implementation file of the word counting engine - File_IO
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "WordCount.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+//==============================================================================
+
+namespace {
+
+inline bool IsWordByte(unsigned char c) {
+    return static_cast<unsigned char>((c | 0x20) - 'a') < 26 || static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline char Lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+// FNV-1a on the lower case bytes.
+inline uint64_t HashWord(const char* Word, std::size_t Length) {
+    uint64_t Hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < Length; ++i) {
+        Hash ^= static_cast<unsigned char>(Lower(Word[i]));
+        Hash *= 1099511628211ull;
+    }
+    return Hash;
+}
+
+inline bool SameWord(const char* Stored, const char* Word, std::size_t Length) {
+    for (std::size_t i = 0; i < Length; ++i)
+        if (Stored[i] != Lower(Word[i])) return false;
+    return true;
+}
+
+#ifdef __SSE2__
+// Bit i set when byte i of the 16 is a word byte.
+inline unsigned WordMask(const char* Bytes) {
+    __m128i X = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Bytes));
+    // Unsigned "x - Low <= Span" with saturating arithmetic.
+    __m128i Letter = _mm_sub_epi8(_mm_or_si128(X, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i Digit = _mm_sub_epi8(X, _mm_set1_epi8('0'));
+    __m128i IsLetter = _mm_cmpeq_epi8(_mm_subs_epu8(Letter, _mm_set1_epi8(25)), _mm_setzero_si128());
+    __m128i IsDigit = _mm_cmpeq_epi8(_mm_subs_epu8(Digit, _mm_set1_epi8(9)), _mm_setzero_si128());
+    return _mm_movemask_epi8(_mm_or_si128(IsLetter, IsDigit));
+}
+#endif
+
+} // namespace
+
+void Tokenize(const char* Begin, const char* End, WordTable& Table) {
+    const char* Word = nullptr; // start of the word being read, if any
+    const char* c = Begin;
+#ifdef __SSE2__
+    for (; c + 16 <= End; c += 16) {
+        unsigned Mask = WordMask(c);
+        if (Mask == 0 && Word == nullptr) continue;
+        if (Mask == 0xFFFF && Word != nullptr) continue; // all inside a word
+        // Starts: word byte after a non word byte; ends: the reverse.
+        unsigned Previous = (Mask << 1) | (Word != nullptr ? 1 : 0);
+        unsigned Starts = Mask & ~Previous & 0xFFFF;
+        unsigned Ends = ~Mask & Previous & 0xFFFF;
+        while (Starts != 0 || Ends != 0) {
+            unsigned S = Starts ? __builtin_ctz(Starts) : 32, E = Ends ? __builtin_ctz(Ends) : 32;
+            if (E < S) {
+                Table.Add(Word, c + E - Word);
+                Word = nullptr;
+                Ends &= Ends - 1;
+            } else {
+                Word = c + S;
+                Starts &= Starts - 1;
+            }
+        }
+    }
+#endif
+    for (; c < End; ++c) {
+        if (IsWordByte(*c)) {
+            if (Word == nullptr) Word = c;
+        } else if (Word != nullptr) {
+            Table.Add(Word, c - Word);
+            Word = nullptr;
+        }
+    }
+    if (Word != nullptr) Table.Add(Word, End - Word);
+}
+
+WordTable::WordTable(): Slots(1024, Entry{0, 0, 0, 0}), Used(0) {}
+
+void WordTable::Grow() {
+    std::vector<Entry> Old(Slots.size() * 2, Entry{0, 0, 0, 0});
+    Old.swap(Slots);
+    const std::size_t Mask = Slots.size() - 1;
+    for (const Entry& E : Old) {
+        if (E.Count == 0) continue;
+        std::size_t s = E.Hash & Mask;
+        while (Slots[s].Count != 0) s = (s + 1) & Mask;
+        Slots[s] = E;
+    }
+}
+
+void WordTable::Add(const char* Word, std::size_t Length, uint64_t Count) {
+    const uint64_t Hash = HashWord(Word, Length);
+    const std::size_t Mask = Slots.size() - 1;
+    for (std::size_t s = Hash & Mask; ; s = (s + 1) & Mask) {
+        Entry& E = Slots[s];
+        if (E.Count == 0) {
+            E = Entry{Hash, Arena.size(), static_cast<uint32_t>(Length), Count};
+            for (std::size_t i = 0; i < Length; ++i) Arena += Lower(Word[i]);
+            if (2 * ++Used > Slots.size()) Grow();
+            return;
+        }
+        if (E.Hash == Hash && E.Length == Length && SameWord(&Arena[E.Offset], Word, Length)) {
+            E.Count += Count;
+            return;
+        }
+    }
+}
+
+void WordTable::Merge(const WordTable& Other) {
+    for (const Entry& E : Other.Slots)
+        if (E.Count != 0) Add(&Other.Arena[E.Offset], E.Length, E.Count);
+}
+
+uint64_t WordTable::Total() const {
+    uint64_t Sum = 0;
+    for (const Entry& E : Slots) Sum += E.Count;
+    return Sum;
+}
+
+std::vector<std::pair<std::string, uint64_t> > WordTable::Sorted() const {
+    std::vector<std::pair<std::string, uint64_t> > Words;
+    Words.reserve(Used);
+    for (const Entry& E : Slots)
+        if (E.Count != 0) Words.emplace_back(Arena.substr(E.Offset, E.Length), E.Count);
+    std::sort(Words.begin(), Words.end(),
+              [](const std::pair<std::string, uint64_t>& A, const std::pair<std::string, uint64_t>& B) {
+                  return A.second > B.second || (A.second == B.second && A.first < B.first);
+              });
+    return Words;
+}
+
+void CountWords(const char* Data, std::size_t Size, unsigned Threads, WordTable& Counts) {
+    if (Threads == 0) Threads = 1;
+    if (Size < (std::size_t(1) << 20)) Threads = 1;
+    // Chunk borders moved forward to the next non word byte.
+    std::vector<std::size_t> Bounds(1, 0);
+    for (unsigned t = 1; t < Threads; ++t) {
+        std::size_t Cut = std::max(Bounds.back(), Size * t / Threads);
+        while (Cut < Size && IsWordByte(Data[Cut])) ++Cut;
+        Bounds.push_back(Cut);
+    }
+    Bounds.push_back(Size);
+
+    std::vector<std::unique_ptr<WordTable> > Tables;
+    std::vector<std::thread> Workers;
+    for (unsigned t = 1; t < Threads; ++t) Tables.emplace_back(new WordTable);
+    for (unsigned t = 1; t < Threads; ++t)
+        Workers.emplace_back([&, t]() { Tokenize(Data + Bounds[t], Data + Bounds[t + 1], *Tables[t - 1]); });
+    // The caller's table takes the first chunk.
+    Tokenize(Data, Data + Bounds[1], Counts);
+    for (std::thread& Worker : Workers) Worker.join();
+    for (const std::unique_ptr<WordTable>& Table : Tables) Counts.Merge(*Table);
+}
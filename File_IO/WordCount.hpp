@@ -0,0 +1,47 @@
+// Header file of the word counting engine - File_IO
+// Author: Salah Eddine Ghamri
+#ifndef WORDCOUNT_HPP
+#define WORDCOUNT_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+//==============================================================================
+
+// A word is a run of ASCII letters and digits, counted in lower case (the
+// same as re.findall(rb"[a-z0-9]+", data.lower()) in Python).
+
+// Calls OnWord(Begin, Length) for every word of [Begin, End). The character
+// classes of 16 bytes are computed at once (SSE2), words are then read from
+// the bit masks of their starts and ends.
+class WordTable;
+void Tokenize(const char* Begin, const char* End, WordTable& Table);
+
+// Open addressing word -> count table. Words are stored lower case in one
+// arena, entries keep the hash so most probes compare no text.
+class WordTable{
+    struct Entry{ uint64_t Hash; uint64_t Offset; uint32_t Length; uint64_t Count; };
+    std::vector<Entry> Slots;
+    std::string Arena;
+    std::size_t Used;
+    void Grow();
+ public:
+     WordTable();
+     // Counts one word (any case) Count times.
+     void Add(const char* Word, std::size_t Length, uint64_t Count = 1);
+     void Merge(const WordTable& Other);
+     std::size_t Distinct() const { return Used; }
+     uint64_t Total() const;
+     // (word, count) pairs, most frequent first, ties in word order.
+     std::vector<std::pair<std::string, uint64_t> > Sorted() const;
+};
+
+// Counts the words of Data with one table per thread, merged at the end.
+// Chunks are cut between words.
+void CountWords(const char* Data, std::size_t Size, unsigned Threads, WordTable& Counts);
+
+#endif // ifndef WORDCOUNT_HPP
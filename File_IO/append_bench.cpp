@@ -0,0 +1,39 @@
+// Commit latency of appending results to a file: one write() per line,
+// durable once fdatasync() returns (what "commit" means here).
+// Usage: ./append_bench <file> [appends]     (the file is appended to)
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Histogram.hpp"
+using namespace std;
+
+int main(int argc, char** argv){
+    if (argc < 2) {
+        cout << "Usage: append_bench <file> [appends]" << endl;
+        return 1;
+    }
+    int appends = (argc > 2) ? stoi(argv[2]) : 1000;
+    int fd = open(argv[1], O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) { cout << " Errors in opening file "<< endl; return 1; }
+
+    Histogram write_time, commit_time;
+    for (int i = 0; i < appends; ++i) {
+        string line = to_string(i * 90) + ".\n";
+        auto start = chrono::steady_clock::now();
+        if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+            cout << " Errors in writing file "<< endl;
+            return 1;
+        }
+        auto written = chrono::steady_clock::now();
+        fdatasync(fd);
+        auto committed = chrono::steady_clock::now();
+        write_time.Record(chrono::duration_cast<chrono::nanoseconds>(written - start).count());
+        commit_time.Record(chrono::duration_cast<chrono::nanoseconds>(committed - start).count());
+    }
+    close(fd);
+    write_time.Print("append write");
+    commit_time.Print("append commit");
+    return 0;
+}
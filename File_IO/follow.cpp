@@ -0,0 +1,35 @@
+// Follow mode of The_file.txt processing: every two integer lines appended
+// to a followed file get their product appended as "<product>." (see
+// TailFollow.hpp). Runs until interrupted.
+// Usage: ./follow [-e] <file>...     (-e: skip what the files already hold)
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <csignal>
+#include "TailFollow.hpp"
+using namespace std;
+
+static Follower* following = nullptr;
+
+static void OnSignal(int) {
+    if (following) following->Stop();
+}
+
+int main(int argc, char** argv){
+    bool from_end = false;
+    int i = 1;
+    if (i < argc && strcmp(argv[i], "-e") == 0) { from_end = true; ++i; }
+    if (i >= argc) {
+        cerr << "Usage: follow [-e] <file>..." << endl;
+        return 2;
+    }
+    Follower follower;
+    for (; i < argc; ++i)
+        if (!follower.Add(argv[i], from_end)) { cerr << " Errors in opening file " << argv[i] << endl; return 2; }
+    follower.OnResult = [&](int, long long result) { cerr << "appended " << result << endl; };
+    following = &follower;
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    follower.Run();
+    return 0;
+}
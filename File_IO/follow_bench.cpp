@@ -0,0 +1,62 @@
+// Latency of the follow mode: a writer appends two operands in one write(),
+// the time until the follower has appended their product is recorded.
+// Usage: ./follow_bench [appends] [dir]    (a scratch file is made in dir)
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Histogram.hpp"
+#include "TailFollow.hpp"
+using namespace std;
+
+int main(int argc, char** argv){
+    int appends = (argc > 1) ? stoi(argv[1]) : 1000;
+    string path = string((argc > 2) ? argv[2] : "/tmp") + "/follow_bench.txt";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd < 0) { cout << " Errors in opening file "<< endl; return 1; }
+
+    Histogram latency;
+    mutex lock;
+    condition_variable done;
+    chrono::steady_clock::time_point sent;
+    int results = 0;
+
+    Follower follower;
+    if (!follower.Add(path, true)) { cout << " Errors in following file "<< endl; return 1; }
+    follower.OnResult = [&](int, long long) {
+        auto now = chrono::steady_clock::now();
+        lock_guard<mutex> guard(lock);
+        latency.Record(chrono::duration_cast<chrono::nanoseconds>(now - sent).count());
+        ++results;
+        done.notify_one();
+    };
+    thread following([&] { follower.Run(); });
+    // Let the follower reach poll() before the first append.
+    this_thread::sleep_for(chrono::milliseconds(50));
+
+    bool failed = false;
+    for (int i = 0; i < appends && !failed; ++i) {
+        string operands = "Operand:\n" + to_string(i) + "\nTimes:\n9\n";
+        unique_lock<mutex> guard(lock);
+        sent = chrono::steady_clock::now();
+        if (write(fd, operands.data(), operands.size()) != static_cast<ssize_t>(operands.size())) {
+            cout << " Errors in writing file "<< endl;
+            failed = true;
+        } else if (!done.wait_for(guard, chrono::seconds(5), [&] { return results == i + 1; })) {
+            cout << " No result after 5 s "<< endl;
+            failed = true;
+        }
+    }
+    // The follower thread must be joined on every path.
+    follower.Stop();
+    following.join();
+    close(fd);
+    unlink(path.c_str());
+    if (failed) return 1;
+    latency.Print("append -> result", "ns");
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Spells the integers read from stdin, one line of words per number (see
+// NumberWords.hpp). With -b, spells Count random numbers in memory instead
+// and prints the rate; timing goes to stderr.
+// Usage: ./numwords < numbers.txt        ./numwords -b <count>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstring>
+#include "NumberWords.hpp"
+using namespace std;
+
+// Spells in batches of this many numbers, through one reused buffer.
+const size_t Batch = 4096;
+
+static int Benchmark(size_t count) {
+    // Mixed magnitudes: uniform over the number of digits, then the digits.
+    mt19937_64 random(42);
+    vector<int64_t> values(count);
+    for (int64_t& v : values) {
+        uint64_t limit = 1;
+        for (int digits = random() % 19; digits > 0; --digits) limit *= 10;
+        v = static_cast<int64_t>(random() % (limit * 10 - 1));
+        if (random() % 8 == 0) v = -v;
+    }
+    vector<char> out(Batch * MaxWordsLength);
+    size_t bytes = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i += Batch)
+        bytes += NumbersToWords(values.data() + i, min(Batch, count - i), out.data());
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << count << " numbers, " << bytes << " bytes of words" << endl;
+    cerr << elapsed.count() << " s, " << count / elapsed.count() / 1e6 << " M numbers/s" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv){
+    if (argc == 3 && strcmp(argv[1], "-b") == 0) return Benchmark(stoull(argv[2]));
+    if (argc != 1) {
+        cerr << "Usage: numwords < numbers.txt  or  numwords -b <count>" << endl;
+        return 2;
+    }
+    vector<int64_t> values;
+    vector<char> out(Batch * MaxWordsLength);
+    long long value;
+    auto start = chrono::steady_clock::now();
+    size_t count = 0;
+    bool more = true;
+    while (more) {
+        values.clear();
+        while (values.size() < Batch && (more = (scanf("%lld", &value) == 1))) values.push_back(value);
+        fwrite(out.data(), 1, NumbersToWords(values.data(), values.size(), out.data()), stdout);
+        count += values.size();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cerr << elapsed.count() << " s, " << count << " numbers" << endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/python
+"""Spells the integers read from stdin, same words and output as ./numwords.
+
+usage: numwords.py < numbers.txt      numwords.py -b <count>
+"""
+import random
+import sys
+import time
+
+ONES = ["zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
+        "ten", "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen",
+        "seventeen", "eighteen", "nineteen"]
+TENS = ["", "", "twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty", "ninety"]
+SCALES = ["", " thousand", " million", " billion", " trillion", " quadrillion", " quintillion"]
+
+
+def below_thousand(n):
+    words = []
+    if n >= 100:
+        words.append(ONES[n // 100] + " hundred")
+        n %= 100
+        if n == 0:
+            return words[0]
+    if n >= 20:
+        words.append(TENS[n // 10] + ("-" + ONES[n % 10] if n % 10 else ""))
+    else:
+        words.append(ONES[n])
+    return " ".join(words)
+
+
+def spell(n):
+    if n == 0:
+        return "zero"
+    if n < 0:
+        return "minus " + spell(-n)
+    groups = []
+    scale = 0
+    while n:
+        n, group = divmod(n, 1000)
+        if group:
+            groups.append(below_thousand(group) + SCALES[scale])
+        scale += 1
+    return " ".join(reversed(groups))
+
+
+def main():
+    if len(sys.argv) == 3 and sys.argv[1] == "-b":
+        rng = random.Random(42)
+        values = []
+        for _ in range(int(sys.argv[2])):
+            value = rng.randrange(10 ** (rng.randrange(19) + 1) - 1)
+            values.append(-value if rng.random() < 0.125 else value)
+        start = time.perf_counter()
+        size = sum(len(spell(value)) + 1 for value in values)
+        elapsed = time.perf_counter() - start
+        print("%d numbers, %d bytes of words" % (len(values), size))
+        sys.stderr.write("%f s, %f M numbers/s\n" % (elapsed, len(values) / elapsed / 1e6))
+        return
+    start = time.perf_counter()
+    numbers = sys.stdin.read().split()
+    sys.stdout.write("".join(spell(int(number)) + "\n" for number in numbers))
+    sys.stderr.write("%f s, %d numbers\n" % (time.perf_counter() - start, len(numbers)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+#!/usr/bin/python
+"""./numwords against numwords.py: same spelling, then throughput.
+
+usage: numwords_bench.py <numwords binary> [count, default 1000000]
+The edge cases (0, powers of ten, both ends of int64) and random numbers are
+spelled by both through stdin and the outputs compared; then each spells
+count numbers in memory (-b) and the rates are printed.
+"""
+import os
+import random
+import subprocess
+import sys
+
+def main():
+    binary = sys.argv[1]
+    count = sys.argv[2] if len(sys.argv) > 2 else "1000000"
+    script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "numwords.py")
+
+    rng = random.Random(7)
+    numbers = [0, 1, -1, 2 ** 63 - 1, -2 ** 63, 100, 1000, 1001, 1000000, 999999999999999999]
+    numbers += [10 ** k for k in range(19)] + [-(10 ** k) for k in range(19)]
+    numbers += [rng.randrange(-2 ** 63, 2 ** 63) for _ in range(50000)]
+    numbers += [rng.randrange(100000) for _ in range(50000)]
+    text = "".join("%d\n" % number for number in numbers).encode()
+    ours = subprocess.run([binary], input=text, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL).stdout
+    theirs = subprocess.run([sys.executable, script], input=text, stdout=subprocess.PIPE,
+                            stderr=subprocess.DEVNULL).stdout
+    if ours != theirs:
+        print("outputs differ")
+        return 1
+    print("%d numbers spelled the same" % len(numbers))
+
+    for name, command in (("numwords", [binary]), ("numwords.py", [sys.executable, script])):
+        result = subprocess.run(command + ["-b", count], stdout=subprocess.DEVNULL,
+                                stderr=subprocess.PIPE)
+        print("%-12s %s" % (name, result.stderr.decode().strip()))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
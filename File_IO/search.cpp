@@ -0,0 +1,48 @@
+// Finds markers in text files: prints "offset:pattern" for every occurrence.
+// Usage: ./search [-c] [-t threads] <file> <pattern> [pattern...]
+//   -c : only print the number of occurrences of each pattern.
+// Timing and throughput go to stderr.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "MappedFile.hpp"
+#include "TextSearch.hpp"
+using namespace std;
+
+int main(int argc, char** argv){
+    bool count_only = false;
+    unsigned threads = thread::hardware_concurrency();
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; ++i) {
+        if (strcmp(argv[i], "-c") == 0) count_only = true;
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = stoi(argv[++i]);
+        else { cerr << "Unknown option " << argv[i] << endl; return 2; }
+    }
+    if (argc - i < 2) {
+        cerr << "Usage: search [-c] [-t threads] <file> <pattern> [pattern...]" << endl;
+        return 2;
+    }
+    MappedFile file;
+    if (!file.Open(argv[i])) { cerr << " Errors in opening file "<< endl; return 2; }
+    vector<string> patterns(argv + i + 1, argv + argc);
+
+    auto start = chrono::steady_clock::now();
+    vector<Match> matches = SearchText(file.Data(), file.Size(), patterns, threads);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (count_only) {
+        vector<size_t> counts(patterns.size(), 0);
+        for (const Match& m : matches) ++counts[m.Pattern];
+        for (size_t p = 0; p < patterns.size(); ++p) cout << counts[p] << " " << patterns[p] << "\n";
+    } else {
+        string out;
+        for (const Match& m : matches) out += to_string(m.Offset) + ":" + to_string(m.Pattern) + "\n";
+        cout << out;
+    }
+    cerr << matches.size() << " matches in " << elapsed.count() << " s, "
+         << file.Size() / elapsed.count() / 1e6 << " MB/s" << endl;
+    return matches.empty() ? 1 : 0;
+}
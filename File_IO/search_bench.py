@@ -0,0 +1,88 @@
+#!/usr/bin/python
+"""Throughput of ./search against grep and Python's str.find.
+
+usage: search_bench.py <search binary> [size in MB] [log file]
+Without a log file, one is generated (the marker of The_file.txt once
+every 1000 lines) and deleted at the end.
+"""
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+MARKER = "give it's multiplcation with the following number:"
+OTHERS = ["worker 63 processed", "record 4242"]
+
+
+def make_log(path, megabytes):
+    rng = random.Random(42)
+    with open(path, "w") as log:
+        written, line = 0, 0
+        while written < megabytes << 20:
+            chunk = []
+            for _ in range(1000):
+                chunk.append("2018-11-16 12:00:%d worker %d processed record %d\n"
+                             % (line % 60, rng.randrange(64), rng.randrange(1 << 32)))
+                line += 1
+            chunk.append(MARKER + "\n5\n")
+            text = "".join(chunk)
+            log.write(text)
+            written += len(text)
+
+
+def timed(command):
+    # Output through a pipe: GNU grep stops at the first match when its
+    # stdout is /dev/null.
+    start = time.perf_counter()
+    subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    return time.perf_counter() - start
+
+
+def python_find(path, patterns):
+    # str.find from every previous match + 1: all occurrences, like ./search.
+    with open(path) as log:
+        text = log.read()
+    start = time.perf_counter()
+    count = 0
+    for pattern in patterns:
+        position = text.find(pattern)
+        while position >= 0:
+            count += 1
+            position = text.find(pattern, position + 1)
+    return time.perf_counter() - start, count
+
+
+def main():
+    search = sys.argv[1]
+    megabytes = int(sys.argv[2]) if len(sys.argv) > 2 else 256
+    folder = None
+    if len(sys.argv) > 3:
+        path = sys.argv[3]
+    else:
+        folder = tempfile.mkdtemp()
+        path = os.path.join(folder, "log.txt")
+        make_log(path, megabytes)
+    size = os.path.getsize(path) / 1e6
+    subprocess.run(["cat", path], stdout=subprocess.DEVNULL)  # warm page cache
+
+    for patterns in ([MARKER], [MARKER] + OTHERS):
+        grep = ["grep", "-F", "-o", "-b"]
+        for pattern in patterns:
+            grep += ["-e", pattern]
+        results = [("search", timed([search, "-c", path] + patterns)),
+                   ("search -t 1", timed([search, "-c", "-t", "1", path] + patterns)),
+                   ("grep -F -o -b", timed(grep + [path]))]
+        seconds, count = python_find(path, patterns)
+        results.append(("python str.find", seconds))
+        print("%d pattern(s), %.0f MB, %d matches:" % (len(patterns), size, count))
+        for name, seconds in results:
+            print("  %-16s %8.3f s %9.1f MB/s" % (name, seconds, size / seconds))
+    if folder:
+        os.remove(path)
+        os.rmdir(folder)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,55 @@
+// Reads every number on stdin with one input method and prints their count
+// and sum, so the methods can be timed against each other on the same
+// input (see stdin_bench.py); timing goes to stderr.
+// Usage: ./stdin_bench <fast|cin|cin-nosync|scanf> <int|double> < numbers.txt
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include "FastInput.hpp"
+using namespace std;
+
+// Sum is unsigned for integers: wrapping on overflow is then defined.
+template <typename T, typename Sum>
+static void ReadAll(const string& method, size_t& count, Sum& sum) {
+    T value;
+    if (method == "fast") {
+        FastInput in;
+        if (!in.Open(0)) return;
+        int64_t i;
+        double d;
+        if (is_integral<T>::value)
+            while (in.ReadInt(i)) { sum += i; ++count; }
+        else
+            while (in.ReadDouble(d)) { sum += d; ++count; }
+    } else if (method == "scanf") {
+        const char* format = is_integral<T>::value ? "%ld" : "%lf";
+        while (scanf(format, &value) == 1) { sum += value; ++count; }
+    } else {
+        if (method == "cin-nosync") ios::sync_with_stdio(false);
+        while (cin >> value) { sum += value; ++count; }
+    }
+}
+
+int main(int argc, char** argv){
+    if (argc != 3) {
+        cerr << "Usage: stdin_bench <fast|cin|cin-nosync|scanf> <int|double>" << endl;
+        return 2;
+    }
+    string method = argv[1], kind = argv[2];
+    size_t count = 0;
+    auto start = chrono::steady_clock::now();
+    if (kind == "int") {
+        uint64_t sum = 0;
+        ReadAll<int64_t>(method, count, sum);
+        printf("%zu numbers, sum %lld\n", count, static_cast<long long>(static_cast<int64_t>(sum)));
+    } else {
+        double sum = 0;
+        ReadAll<double>(method, count, sum);
+        printf("%zu numbers, sum %.17g\n", count, sum);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cerr << elapsed.count() << " s" << endl;
+    return 0;
+}
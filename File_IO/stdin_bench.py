@@ -0,0 +1,77 @@
+#!/usr/bin/python
+"""Input methods compared on bulk numbers: FastInput, cin (synced and not),
+scanf and Python sys.stdin, from a redirected file and through a pipe.
+
+usage: stdin_bench.py <stdin_bench binary> [count, default 10000000]
+All methods must print the same count and sum, else it stops.
+"""
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+def make_numbers(path, kind, count):
+    rng = random.Random(42)
+    with open(path, "w") as out:
+        for start in range(0, count, 100000):
+            block = range(start, min(count, start + 100000))
+            if kind == "int":
+                out.write("".join("%d\n" % rng.randrange(-10 ** rng.randrange(1, 19), 10 ** 18)
+                                  for _ in block))
+            else:
+                out.write("".join("%.*f\n" % (rng.randrange(7), rng.uniform(-1e6, 1e6))
+                                  for _ in block))
+
+
+def timed(command, path, piped):
+    start = time.perf_counter()
+    if piped:
+        feed = subprocess.Popen(["cat", path], stdout=subprocess.PIPE)
+        result = subprocess.run(command, stdin=feed.stdout, stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL)
+        feed.wait()
+    else:
+        with open(path) as numbers:
+            result = subprocess.run(command, stdin=numbers, stdout=subprocess.PIPE,
+                                    stderr=subprocess.DEVNULL)
+    return time.perf_counter() - start, result.stdout
+
+
+def main():
+    binary = sys.argv[1]
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 10000000
+    script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "stdin_sum.py")
+    methods = [("fast", [binary, "fast"]), ("scanf", [binary, "scanf"]),
+               ("cin-nosync", [binary, "cin-nosync"]), ("cin", [binary, "cin"]),
+               ("python read", [sys.executable, script, "read"]),
+               ("python lines", [sys.executable, script, "lines"])]
+    folder = tempfile.mkdtemp()
+    try:
+        for kind in ("int", "double"):
+            path = os.path.join(folder, kind + ".txt")
+            make_numbers(path, kind, count)
+            megabytes = os.path.getsize(path) / 1e6
+            print("%d %ss, %.0f MB" % (count, kind, megabytes))
+            print("%-14s %12s %12s" % ("method", "file MB/s", "pipe MB/s"))
+            expected = None
+            for name, command in methods:
+                speeds = []
+                for piped in (False, True):
+                    elapsed, output = timed(command + [kind], path, piped)
+                    if expected is None:
+                        expected = output
+                    if output != expected:
+                        print("%s disagrees: %s" % (name, output.decode().strip()))
+                        return 1
+                    speeds.append(megabytes / elapsed)
+                print("%-14s %12.0f %12.0f" % (name, speeds[0], speeds[1]))
+    finally:
+        shutil.rmtree(folder)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,35 @@
+#!/usr/bin/python
+"""Count and sum of the numbers on stdin, same output as ./stdin_bench.
+
+usage: stdin_sum.py <lines|read> <int|double> < numbers.txt
+lines iterates sys.stdin, read splits sys.stdin.buffer.read().
+"""
+import sys
+import time
+
+
+def main():
+    method, kind = sys.argv[1], sys.argv[2]
+    parse = int if kind == "int" else float
+    start = time.perf_counter()
+    count, total = 0, 0 if kind == "int" else 0.0
+    if method == "lines":
+        for line in sys.stdin:
+            for token in line.split():
+                total += parse(token)
+                count += 1
+    else:
+        for token in sys.stdin.buffer.read().split():
+            total += parse(token)
+            count += 1
+    if kind == "int":
+        # Wraps like the 64-bit sum of ./stdin_bench.
+        total = (total + 2 ** 63) % 2 ** 64 - 2 ** 63
+        print("%d numbers, sum %d" % (count, total))
+    else:
+        print("%d numbers, sum %s" % (count, "%.17g" % total))
+    sys.stderr.write("%f s\n" % (time.perf_counter() - start))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,42 @@
+// Counts the words of a text file (see WordCount.hpp for what a word is).
+// Usage: ./wordcount [-t threads] [-n top] <file>
+// Prints "count word" for the top words (all of them with -n 0), then the
+// totals; timing goes to stderr.
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "MappedFile.hpp"
+#include "WordCount.hpp"
+using namespace std;
+
+int main(int argc, char** argv){
+    unsigned threads = thread::hardware_concurrency();
+    size_t top = 20;
+    int i = 1;
+    for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        if (strcmp(argv[i], "-t") == 0) threads = stoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-n") == 0) top = stoul(argv[i + 1]);
+        else { cerr << "Unknown option " << argv[i] << endl; return 2; }
+    }
+    if (i + 1 != argc) {
+        cerr << "Usage: wordcount [-t threads] [-n top] <file>" << endl;
+        return 2;
+    }
+    MappedFile file;
+    if (!file.Open(argv[i])) { cerr << " Errors in opening file "<< endl; return 2; }
+
+    auto start = chrono::steady_clock::now();
+    WordTable counts;
+    CountWords(file.Data(), file.Size(), threads, counts);
+    auto words = counts.Sorted();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (top == 0 || top > words.size()) top = words.size();
+    string out;
+    for (size_t w = 0; w < top; ++w) out += to_string(words[w].second) + " " + words[w].first + "\n";
+    cout << out << counts.Total() << " words, " << counts.Distinct() << " distinct" << endl;
+    cerr << elapsed.count() << " s, " << file.Size() / elapsed.count() / 1e6 << " MB/s" << endl;
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/python
+"""Word count with collections.Counter, same words and output as ./wordcount.
+
+usage: wordcount.py [-n top] <file>
+"""
+import re
+import sys
+import time
+from collections import Counter
+
+
+def main():
+    top, path = 20, sys.argv[-1]
+    if len(sys.argv) == 4 and sys.argv[1] == "-n":
+        top = int(sys.argv[2])
+    start = time.perf_counter()
+    with open(path, "rb") as text:
+        counts = Counter(re.findall(rb"[a-z0-9]+", text.read().lower()))
+    words = sorted(counts.items(), key=lambda item: (-item[1], item[0]))
+    elapsed = time.perf_counter() - start
+    if top == 0 or top > len(words):
+        top = len(words)
+    out = sys.stdout
+    for word, count in words[:top]:
+        out.write("%d %s\n" % (count, word.decode()))
+    out.write("%d words, %d distinct\n" % (sum(counts.values()), len(counts)))
+    sys.stderr.write("%f s\n" % elapsed)
+
+
+if __name__ == "__main__":
+    main()
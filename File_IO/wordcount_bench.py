@@ -0,0 +1,67 @@
+#!/usr/bin/python
+"""./wordcount against wordcount.py (collections.Counter) from 1 MB up.
+
+usage: wordcount_bench.py <wordcount binary> [largest size in MB, default 1024]
+Sizes go 1, 10, 100, ... MB up to the largest (10000 for 10 GB). Inputs are
+generated in a temporary folder (a size is skipped when the disk is too
+small) and both outputs are checked to be identical.
+"""
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+def make_text(path, megabytes):
+    # Zipf-like word frequencies, mixed case and punctuation.
+    rng = random.Random(42)
+    words = ["".join(rng.choice("abcdefghijklmnopqrstuvwxyz") for _ in range(rng.randint(2, 10)))
+             for _ in range(50000)]
+    weights = [1.0 / (rank + 1) for rank in range(len(words))]
+    block = []
+    for word in rng.choices(words, weights, k=200000):
+        block.append(word.capitalize() if rng.random() < 0.1 else word)
+        block.append(rng.choice([" ", " ", " ", ", ", ". ", "\n"]))
+    block = "".join(block)
+    with open(path, "w") as text:
+        written = 0
+        while written < megabytes << 20:
+            part = block[:(megabytes << 20) - written]
+            text.write(part)
+            written += len(part)
+
+
+def timed(command):
+    start = time.perf_counter()
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    return time.perf_counter() - start, result.stdout
+
+
+def main():
+    binary = sys.argv[1]
+    largest = int(sys.argv[2]) if len(sys.argv) > 2 else 1024
+    script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "wordcount.py")
+    folder = tempfile.mkdtemp()
+    try:
+        megabytes = 1
+        while megabytes <= largest:
+            if shutil.disk_usage(folder).free < 2 * (megabytes << 20):
+                print("%6d MB: skipped, not enough disk space" % megabytes)
+                break
+            path = os.path.join(folder, "text.txt")
+            make_text(path, megabytes)
+            native, native_out = timed([binary, path])
+            python, python_out = timed([sys.executable, script, path])
+            print("%6d MB: wordcount %8.3f s (%7.1f MB/s)  Counter %8.3f s (%7.1f MB/s)  %.1fx  %s"
+                  % (megabytes, native, megabytes / native, python, megabytes / python,
+                     python / native, "same" if native_out == python_out else "OUTPUT DIFFERS"))
+            os.remove(path)
+            megabytes *= 10
+    finally:
+        shutil.rmtree(folder)
+
+
+if __name__ == "__main__":
+    main()
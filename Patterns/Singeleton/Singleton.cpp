@@ -1,10 +1,15 @@
+// Build: g++ -O2 -I../../Tools Singleton.cpp ../../Tools/Histogram.cpp -pthread
+// "./a.out bench [threads]" measures the GetInstance latency.
 #include<string>
 #include <chrono>
 #include <cstddef>
 #include <thread>
 #include <iostream>
 #include <mutex>
-#include <time>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include "Histogram.hpp"
 
 /**
  * The Singleton class defines the `GetInstance` method that serves as an
@@ -97,8 +102,36 @@ void ThreadBar(){
     std::cout << singleton->value() << "\n";
 }
 
-int main()
+void BenchGetInstance(int threads){
+    // Every call takes the mutex: this is the cost of the pattern once the
+    // instance exists, under contention.
+    const int calls = 100000;
+    std::vector<std::unique_ptr<Histogram>> latencies;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) latencies.emplace_back(new Histogram);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&latencies, t, calls]() {
+            for (int i = 0; i < calls; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                Singleton::GetInstance("BENCH");
+                auto end = std::chrono::steady_clock::now();
+                latencies[t]->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    Histogram all;
+    for (auto& latency : latencies) all.Merge(*latency);
+    std::cout << threads << " threads:\n";
+    all.Print("GetInstance");
+}
+
+int main(int argc, char** argv)
 {   
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        BenchGetInstance((argc > 2) ? std::stoi(argv[2]) : std::thread::hardware_concurrency());
+        return 0;
+    }
     std::cout <<"If you see the same value, then singleton was reused (yay!\n" <<
                 "If you see different values, then 2 singletons were created (booo!!)\n\n" <<
                 "RESULT:\n";   
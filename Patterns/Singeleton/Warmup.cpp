@@ -0,0 +1,178 @@
+// Implementation file of Warmup - singleton startup initializer
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Warmup.hpp"
+#include <algorithm>
+#include <stdexcept>
+//==============================================================================
+
+namespace Warmup {
+
+Registry::Registry(): Epoch(std::chrono::steady_clock::now()), Finished(0), Threads(0), Started(false) {}
+
+Registry::~Registry() {
+    Drain();
+    for (std::thread& Worker : Pool) Worker.join();
+}
+
+Id Registry::Add(const std::string& Name, const std::vector<Id>& Depends, std::function<void()> Create) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    // Pool threads and Get read Nodes unlocked: it must not grow under them.
+    if (Started) throw std::logic_error("Warmup: " + Name + " declared after Start.");
+    const Id Which = Nodes.size();
+    Nodes.emplace_back(new Node);
+    Node& New = *Nodes.back();
+    New.Name = Name;
+    New.Create = std::move(Create);
+    New.Missing = 0;
+    New.Begin = New.End = 0;
+    for (Id Dependency : Depends) {
+        if (Dependency < 0 || Dependency >= Which) {
+            printf("Warmup: %s depends on an undeclared singleton.\n", Name.c_str());
+            continue;
+        }
+        New.Depends.push_back(Dependency);
+        Nodes[Dependency]->Dependents.push_back(Which);
+        if (Nodes[Dependency]->Status.load() != Done) ++New.Missing;
+    }
+    New.Status.store(Waiting);
+    return Which;
+}
+
+void Registry::Start(unsigned Count) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (Started) return;
+    Started = true;
+    Threads = Count > 0 ? Count : 1;
+    // Times count from Start, unless a Get before it already built some
+    // (they keep the construction of the Registry as origin).
+    if (Finished == 0) Epoch = std::chrono::steady_clock::now();
+    for (Id Which = 0; Which < static_cast<Id>(Nodes.size()); ++Which) {
+        int Expected = Waiting;
+        if (Nodes[Which]->Missing == 0 && Nodes[Which]->Status.compare_exchange_strong(Expected, Queued))
+            Ready.push_back(Which);
+    }
+    for (unsigned t = 0; t < Threads; ++t) Pool.emplace_back(&Registry::Work, this);
+}
+
+void Registry::Work() {
+    // Pool thread: builds ready singletons until all are built.
+    while (true) {
+        Id Which;
+        {
+            std::unique_lock<std::mutex> Guard(Lock);
+            Changed.wait(Guard, [this]() {
+                return !Ready.empty() || Finished == static_cast<int>(Nodes.size());
+            });
+            if (Ready.empty()) return;
+            Which = Ready.front();
+            Ready.erase(Ready.begin());
+        }
+        // Skipped when a caller of Wait took it first.
+        int Expected = Queued;
+        if (Nodes[Which]->Status.compare_exchange_strong(Expected, Running)) Build(Which);
+    }
+}
+
+void Registry::Build(Id Which) {
+    // Runs the constructor of a singleton claimed by this thread (Running).
+    Node& Item = *Nodes[Which];
+    std::exception_ptr Failure;
+    for (Id Dependency : Item.Depends)
+        if (!Failure) Failure = Nodes[Dependency]->Failure;
+    auto Begin = std::chrono::steady_clock::now();
+    if (!Failure) {
+        try {
+            Item.Create();
+        } catch (...) {
+            Failure = std::current_exception();
+        }
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> Guard(Lock);
+    Item.Begin = std::chrono::duration<double, std::milli>(Begin - Epoch).count();
+    Item.End = std::chrono::duration<double, std::milli>(End - Epoch).count();
+    Item.Failure = Failure;
+    Item.Status.store(Done, std::memory_order_release);
+    ++Finished;
+    for (Id Dependent : Item.Dependents) {
+        Node& Next = *Nodes[Dependent];
+        int Expected = Waiting;
+        if (--Next.Missing == 0 && Started && Next.Status.compare_exchange_strong(Expected, Queued))
+            Ready.push_back(Dependent);
+    }
+    Changed.notify_all();
+}
+
+void Registry::Wait(Id Which) {
+    Node& Item = *Nodes[Which];
+    if (Item.Status.load(std::memory_order_acquire) != Done) {
+        for (Id Dependency : Item.Depends) Wait(Dependency);
+        // Not started by anyone: build it here rather than wait for a pool
+        // thread that may be the one calling.
+        int Expected = Waiting;
+        bool Claimed = Item.Status.compare_exchange_strong(Expected, Running);
+        if (!Claimed && Expected == Queued) Claimed = Item.Status.compare_exchange_strong(Expected, Running);
+        if (Claimed) {
+            Build(Which);
+        } else {
+            std::unique_lock<std::mutex> Guard(Lock);
+            Changed.wait(Guard, [&Item]() { return Item.Status.load() == Done; });
+        }
+    }
+    if (Item.Failure) std::rethrow_exception(Item.Failure);
+}
+
+void Registry::WaitAll() {
+    if (!Started) Start(std::thread::hardware_concurrency());
+    Drain();
+}
+
+void Registry::Drain() {
+    std::unique_lock<std::mutex> Guard(Lock);
+    if (!Started) return;
+    Changed.wait(Guard, [this]() { return Finished == static_cast<int>(Nodes.size()); });
+}
+
+void Registry::Report(FILE* Out) const {
+    if (Nodes.empty()) return;
+    double Wall = 0, Work = 0;
+    Id Last = 0;
+    for (Id Which = 0; Which < static_cast<Id>(Nodes.size()); ++Which) {
+        const Node& Item = *Nodes[Which];
+        Work += Item.End - Item.Begin;
+        if (Item.End > Wall) {
+            Wall = Item.End;
+            Last = Which;
+        }
+    }
+    fprintf(Out, "Startup %.1f ms on %u threads, %.1f ms of construction (%.2fx).\n",
+            Wall, Threads, Work, Wall > 0 ? Work / Wall : 0.0);
+    fprintf(Out, "  %-20s %9s %9s %9s %9s\n", "singleton", "start", "end", "took", "queued");
+    for (const std::unique_ptr<Node>& Item : Nodes) {
+        // Queued: between the last dependency being built and its own start.
+        double Ready = 0;
+        for (Id Dependency : Item->Depends) Ready = std::max(Ready, Nodes[Dependency]->End);
+        fprintf(Out, "  %-20s %9.1f %9.1f %9.1f %9.1f%s\n", Item->Name.c_str(), Item->Begin, Item->End,
+                Item->End - Item->Begin, std::max(0.0, Item->Begin - Ready), Item->Failure ? "  failed" : "");
+    }
+    // Critical path: from the last one to end, back through the dependency
+    // that ended last each time.
+    std::vector<Id> Path;
+    for (Id Which = Last; ; ) {
+        Path.push_back(Which);
+        const Node& Item = *Nodes[Which];
+        if (Item.Depends.empty()) break;
+        Which = *std::max_element(Item.Depends.begin(), Item.Depends.end(),
+                                  [this](Id A, Id B) { return Nodes[A]->End < Nodes[B]->End; });
+    }
+    fprintf(Out, "Critical path:");
+    for (auto Step = Path.rbegin(); Step != Path.rend(); ++Step) {
+        const Node& Item = *Nodes[*Step];
+        fprintf(Out, "%s %s (%.1f ms)", Step == Path.rbegin() ? "" : " ->", Item.Name.c_str(), Item.End - Item.Begin);
+    }
+    fprintf(Out, "\n");
+}
+
+} // namespace Warmup
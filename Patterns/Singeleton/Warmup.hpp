@@ -0,0 +1,112 @@
+// Header file of Warmup - singleton startup initializer
+// Author: Salah Eddine Ghamri
+#ifndef WARMUP_HPP
+#define WARMUP_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+//==============================================================================
+
+// Eager, parallel construction of singletons that depend on each other.
+// Every singleton is declared with the ones its construction uses:
+//     Warmup::Registry Startup;
+//     Warmup::Instance<Config> TheConfig(Startup, "config", {}, [] { return new Config; });
+//     Warmup::Instance<Database> TheDb(Startup, "db", {TheConfig.Key()},
+//                                      [] { return new Database(TheConfig.Get()); });
+//     Startup.Start(4);           // returns at once
+//     TheDb.Get().Query(...);     // blocks only until the database is ready
+// Start builds everything on a pool, a singleton as soon as all its
+// dependencies are built (topological order). Get is one atomic load once
+// the instance exists. A Get on an instance nobody started yet (called
+// before Start, or an undeclared dependency inside a constructor) builds it
+// in the calling thread, so a pool thread never waits on queued work.
+// A constructor that throws makes every Get of it (and of what depends on
+// it) rethrow. Declare the Registry before its Instances, and all of them
+// from one thread before Start: declaring one after throws logic_error.
+namespace Warmup {
+
+using Id = int;
+
+class Registry{
+    enum State { Waiting, Queued, Running, Done };
+    struct Node{
+        std::string Name;
+        std::vector<Id> Depends, Dependents;
+        std::function<void()> Create;
+        std::atomic<int> Status;
+        int Missing;                   // dependencies not built yet
+        double Begin, End;             // ms since Epoch
+        std::exception_ptr Failure;
+    };
+    std::vector<std::unique_ptr<Node>> Nodes;
+    std::vector<Id> Ready;
+    std::vector<std::thread> Pool;
+    std::mutex Lock;
+    std::condition_variable Changed;
+    std::chrono::steady_clock::time_point Epoch;   // Start, or construction if built before
+    int Finished;
+    unsigned Threads;
+    bool Started;
+    void Build(Id Which);
+    void Work();
+ public:
+     Registry();
+     Registry(const Registry&) = delete;
+     Registry& operator=(const Registry&) = delete;
+     ~Registry();
+     // Declares a singleton; Depends must be declared before it. Throws
+     // std::logic_error once started.
+     Id Add(const std::string& Name, const std::vector<Id>& Depends, std::function<void()> Create);
+     // Builds everything on Threads threads. Returns at once.
+     void Start(unsigned Threads);
+     // Blocks until Which is built (building it here if nobody started it).
+     void Wait(Id Which);
+     void WaitAll();
+     // Waits for the pool if it was started (nothing is built otherwise).
+     void Drain();
+     // After WaitAll: wall time, time of every singleton and the critical
+     // path (the chain of dependencies that ended last).
+     void Report(FILE* Out) const;
+};
+
+template<class T>
+class Instance{
+    Registry& Owner;
+    std::atomic<T*> Object;
+    Id Self;
+ public:
+     Instance(Registry& Startup, const std::string& Name, const std::vector<Id>& Depends,
+              std::function<T*()> Factory)
+         : Owner(Startup), Object(nullptr),
+           Self(Startup.Add(Name, Depends, [this, Factory]() {
+               Object.store(Factory(), std::memory_order_release);
+           })) {}
+     Instance(const Instance&) = delete;
+     Instance& operator=(const Instance&) = delete;
+     ~Instance() {
+         Owner.Drain();
+         delete Object.load();
+     }
+     Id Key() const { return Self; }
+     T& Get() {
+         T* Ready = Object.load(std::memory_order_acquire);
+         if (Ready != nullptr) return *Ready;
+         Owner.Wait(Self);
+         return *Object.load(std::memory_order_acquire);
+     }
+};
+
+} // namespace Warmup
+
+#endif // ifndef WARMUP_HPP
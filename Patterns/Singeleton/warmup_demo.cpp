@@ -0,0 +1,75 @@
+// Startup of a service with a dozen slow singletons: lazily and one after
+// the other (as GetInstance does), then warmed up in parallel by Warmup.
+// Build: g++ -O2 warmup_demo.cpp Warmup.cpp -pthread -o warmup_demo
+// "./warmup_demo [threads]"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "Warmup.hpp"
+
+/**
+ * Stands for any expensive singleton: construction sleeps like ThreadFoo.
+ */
+class Service
+{
+public:
+    Service(const std::string& name, int milliseconds): name_(name)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    }
+    const std::string& name() const { return name_; }
+private:
+    std::string name_;
+};
+
+struct Declaration { const char* name; int milliseconds; std::vector<int> depends; };
+
+// Construction times (ms) and dependencies, by index.
+const std::vector<Declaration> services = {
+    {"config", 100, {}},          // 0
+    {"logger", 50, {0}},          // 1
+    {"database", 300, {0}},       // 2
+    {"cache", 200, {2}},          // 3
+    {"metrics", 80, {1}},         // 4
+    {"auth", 150, {0, 2}},        // 5
+    {"templates", 250, {0}},      // 6
+    {"search", 400, {3}},         // 7
+    {"mailer", 100, {1, 6}},      // 8
+    {"scheduler", 120, {2}},      // 9
+    {"reports", 180, {2, 6}},     // 10
+    {"api", 60, {5, 3, 7}},       // 11
+};
+
+int main(int argc, char** argv)
+{
+    unsigned threads = (argc > 1) ? std::stoi(argv[1]) : 4;
+
+    // Serial: every singleton built on first use, one after the other.
+    auto start = std::chrono::steady_clock::now();
+    for (const Declaration& d : services) Service(d.name, d.milliseconds);
+    std::chrono::duration<double, std::milli> serial = std::chrono::steady_clock::now() - start;
+    printf("Lazy and serial: %.1f ms.\n\n", serial.count());
+
+    // Parallel: declared with their dependencies, built on a pool.
+    Warmup::Registry startup;
+    std::vector<std::unique_ptr<Warmup::Instance<Service>>> instances;
+    for (const Declaration& d : services) {
+        std::vector<Warmup::Id> depends;
+        for (int k : d.depends) depends.push_back(instances[k]->Key());
+        instances.emplace_back(new Warmup::Instance<Service>(startup, d.name, depends,
+            [d]() { return new Service(d.name, d.milliseconds); }));
+    }
+    start = std::chrono::steady_clock::now();
+    startup.Start(threads);
+    // The caller only waits for what it needs: the logger is up early.
+    for (int k : {1, 11}) {
+        const std::string& name = instances[k]->Get().name();
+        std::chrono::duration<double, std::milli> waited = std::chrono::steady_clock::now() - start;
+        printf("%s ready after %.1f ms.\n", name.c_str(), waited.count());
+    }
+    printf("\n");
+    startup.WaitAll();
+    startup.Report(stdout);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Checks of Warmup: declaring a singleton once the pool runs is refused,
+// and the singletons declared before are still built.
+// Build: g++ -O2 warmup_test.cpp Warmup.cpp -pthread -o warmup_test
+// "./warmup_test"   (exit status 0 when every check passes)
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include "Warmup.hpp"
+
+/**
+ * Slow enough that the pool is still building when the late declaration
+ * comes in.
+ */
+struct Slow
+{
+    explicit Slow(int value): value_(value)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    int value_;
+};
+
+int failures = 0;
+
+void check(bool ok, const char* what)
+{
+    printf("%s: %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) ++failures;
+}
+
+int main()
+{
+    Warmup::Registry startup;
+    Warmup::Instance<Slow> first(startup, "first", {}, [] { return new Slow(1); });
+    Warmup::Instance<Slow> second(startup, "second", {first.Key()}, [] { return new Slow(2); });
+    startup.Start(2);
+
+    // Once started, Nodes must not grow under the pool threads.
+    bool refused = false;
+    try {
+        Warmup::Instance<Slow> late(startup, "late", {first.Key()}, [] { return new Slow(3); });
+    } catch (const std::logic_error&) {
+        refused = true;
+    }
+    check(refused, "Instance declared after Start throws logic_error");
+
+    refused = false;
+    try {
+        startup.Add("late", {}, [] {});
+    } catch (const std::logic_error&) {
+        refused = true;
+    }
+    check(refused, "Add after Start throws logic_error");
+
+    check(second.Get().value_ == 2 && first.Get().value_ == 1, "singletons declared before Start are built");
+    startup.WaitAll();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Implementation file for Autotune - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Autotune.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
+//==============================================================================
+
+namespace Autotune {
+namespace {
+
+struct Knob{
+    long Default;
+    std::vector<long> Candidates;
+    Measure Run;
+};
+
+struct Tuned{
+    long Value;
+    double Seconds;
+};
+
+std::mutex Lock;
+std::map<std::string, Knob> Knobs;
+std::map<std::string, Tuned> Values;   // this host's file, other apps included
+bool Loaded = false;
+
+const int RunsPerCandidate = 3;
+
+std::string ReadLine(const std::string& Path) {
+    std::ifstream File(Path);
+    std::string Line;
+    std::getline(File, Line);
+    return Line;
+}
+
+std::string CacheSizes() {
+    // "L1d 48K L1i 32K L2 2048K ..." from the caches of cpu0.
+    std::string Sizes;
+    for (int i = 0; i < 8; ++i) {
+        const std::string Dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(i) + "/";
+        const std::string Level = ReadLine(Dir + "level"), Size = ReadLine(Dir + "size");
+        if (Level.empty() || Size.empty()) break;
+        const std::string Type = ReadLine(Dir + "type");
+        std::string Name = "L" + Level;
+        if (Type == "Data") Name += "d";
+        if (Type == "Instruction") Name += "i";
+        Sizes += (Sizes.empty() ? "" : " ") + Name + " " + Size;
+    }
+    return Sizes.empty() ? "caches unknown" : Sizes;
+}
+
+bool MakeDirectories(const std::string& Path) {
+    // mkdir -p of the directory part of Path.
+    for (std::size_t Slash = Path.find('/', 1); Slash != std::string::npos; Slash = Path.find('/', Slash + 1)) {
+        if (mkdir(Path.substr(0, Slash).c_str(), 0755) != 0 && errno != EEXIST) return false;
+    }
+    return true;
+}
+
+void ReadFile(const std::string& Path, const std::string& Host) {
+    // Values of a file written for this host, nothing otherwise.
+    std::ifstream File(Path);
+    std::string Line;
+    if (!std::getline(File, Line) || Line != "autotune 1") return;
+    if (!std::getline(File, Line) || Line != "host " + Host) return;
+    while (std::getline(File, Line)) {
+        std::istringstream Fields(Line);
+        std::string Name;
+        Tuned Entry;
+        if (Fields >> Name >> Entry.Value >> Entry.Seconds) Values[Name] = Entry;
+    }
+}
+
+bool WriteFile(const std::string& Path, const std::string& Host) {
+    // Written aside then renamed, a concurrent reader sees either file.
+    if (!MakeDirectories(Path)) return false;
+    const std::string Temporary = Path + ".tmp" + std::to_string(getpid());
+    FILE* File = fopen(Temporary.c_str(), "w");
+    if (File == nullptr) return false;
+    fprintf(File, "autotune 1\nhost %s\n", Host.c_str());
+    for (const auto& Entry : Values)
+        fprintf(File, "%s %ld %.6g\n", Entry.first.c_str(), Entry.second.Value, Entry.second.Seconds);
+    const bool Written = (fclose(File) == 0);
+    if (!Written || rename(Temporary.c_str(), Path.c_str()) != 0) {
+        unlink(Temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+Tuned Calibrate(const std::string& Name, const Knob& Setting) {
+    // Median of a few runs per candidate, the fastest candidate wins. The
+    // first run of each candidate also warms caches and page tables.
+    Tuned Best = {Setting.Default, -1};
+    for (long Candidate : Setting.Candidates) {
+        std::vector<double> Runs;
+        for (int r = 0; r < RunsPerCandidate; ++r) Runs.push_back(Setting.Run(Candidate));
+        std::nth_element(Runs.begin(), Runs.begin() + Runs.size() / 2, Runs.end());
+        const double Median = Runs[Runs.size() / 2];
+        fprintf(stderr, "  %-22s %10ld  %9.3f ms\n", Name.c_str(), Candidate, 1e3 * Median);
+        if (Best.Seconds < 0 || Median < Best.Seconds) Best = {Candidate, Median};
+    }
+    return Best;
+}
+
+} // namespace
+
+void Register(const std::string& Name, long Default, const std::vector<long>& Candidates, Measure Run) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Knobs[Name] = {Default, Candidates, Run};
+}
+
+long Get(const std::string& Name, long Default) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto Entry = Values.find(Name);
+    if (Entry == Values.end() || !Loaded) return Default;
+    return Entry->second.Value;
+}
+
+std::string FilePath() {
+    const char* Override = getenv("TASK_TUNING");
+    if (Override != nullptr && Override[0] != '\0') return strcmp(Override, "off") == 0 ? "" : Override;
+    std::string Directory;
+    const char* Cache = getenv("XDG_CACHE_HOME");
+    if (Cache != nullptr && Cache[0] != '\0') Directory = Cache;
+    else if (const char* Home = getenv("HOME")) Directory = std::string(Home) + "/.cache";
+    else Directory = "/tmp";
+    // FNV-1a of the host key: one file per kind of machine.
+    uint64_t Hash = 14695981039346656037ull;
+    for (char c : HostKey()) Hash = (Hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    char Name[32];
+    snprintf(Name, sizeof(Name), "%016llx.txt", static_cast<unsigned long long>(Hash));
+    return Directory + "/task-tuning/" + Name;
+}
+
+std::string HostKey() {
+    std::string Model = "unknown cpu";
+    std::ifstream CpuInfo("/proc/cpuinfo");
+    for (std::string Line; std::getline(CpuInfo, Line); ) {
+        if (Line.compare(0, 10, "model name") != 0) continue;
+        std::size_t Start = Line.find(':');
+        if (Start != std::string::npos) Start = Line.find_first_not_of(" \t", Start + 1);
+        if (Start != std::string::npos) Model = Line.substr(Start);
+        break;
+    }
+    return Model + " | " + std::to_string(std::thread::hardware_concurrency()) + " cpus | " + CacheSizes();
+}
+
+std::vector<long> ThreadCandidates() {
+    const long Cpus = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<long> Counts;
+    for (long Count = 1; Count < Cpus; Count *= 2) Counts.push_back(Count);
+    Counts.push_back(Cpus);
+    return Counts;
+}
+
+bool Load(bool Retune, bool MayCalibrate) {
+    const std::string Path = FilePath();
+    if (Path.empty()) return true;
+    // Without --tune, only a file named by TASK_TUNING is filled in: a
+    // plain run never spends seconds calibrating nor writes to $HOME.
+    const char* Named = getenv("TASK_TUNING");
+    const bool Fill = Retune || (MayCalibrate && Named != nullptr && Named[0] != '\0');
+    const std::string Host = HostKey();
+    std::map<std::string, Knob> Missing;
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        Values.clear();
+        ReadFile(Path, Host);
+        Loaded = true;
+        for (const auto& Entry : Knobs)
+            if (Retune || (Fill && Values.find(Entry.first) == Values.end())) Missing.insert(Entry);
+    }
+    if (Missing.empty()) return true;
+
+    // Unlocked: a calibration run may itself call Get.
+    fprintf(stderr, "Tuning %zu parameters for %s\n", Missing.size(), Host.c_str());
+#ifndef __OPTIMIZE__
+    fprintf(stderr, "Warning: built without optimization, the tuned values may not suit a release build.\n");
+#endif
+    std::map<std::string, Tuned> Found;
+    for (const auto& Entry : Missing) Found[Entry.first] = Calibrate(Entry.first, Entry.second);
+    std::lock_guard<std::mutex> Guard(Lock);
+    for (const auto& Entry : Found) Values[Entry.first] = Entry.second;
+    if (!WriteFile(Path, Host)) {
+        fprintf(stderr, "Could not write the tuning file %s, values kept for this run.\n", Path.c_str());
+        return false;
+    }
+    fprintf(stderr, "Tuning saved to %s\n", Path.c_str());
+    return true;
+}
+
+} // namespace Autotune
@@ -0,0 +1,57 @@
+// Header file of Autotune - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef AUTOTUNE_HPP
+#define AUTOTUNE_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <functional>
+#include <string>
+#include <vector>
+//==============================================================================
+
+// Persistent tuning of block sizes, chunk sizes and thread counts. An app
+// registers its knobs, each with the candidate values and a short
+// calibration run, then calls Load once at startup:
+//     Autotune::Register("task1.pipe_chunk", 1 << 20, {64 << 10, 1 << 20},
+//                        [](long Bytes) { return SecondsToFilter(Bytes); });
+//     Autotune::Load(Tune);
+//     FilterPipe(In, Out, ';', Autotune::Get("task1.pipe_chunk", 1 << 20));
+// Load reads the tuning file of this host. Calibration (every candidate is
+// timed three times, the lowest median wins, then the file is written
+// back) only happens when asked: every knob with Retune (--tune), the
+// knobs missing from the file when TASK_TUNING names it. Otherwise knobs
+// not in the file keep their defaults. The file is keyed by the CPU
+// model, the number of CPUs and the cache sizes, so a copied home
+// directory or a new machine is not given foreign values. Knobs of other
+// apps in the same file are kept. The file is $TASK_TUNING if set ("off"
+// disables tuning, Get then returns the defaults), else
+// $XDG_CACHE_HOME/task-tuning/<hash>.txt (~/.cache when XDG_CACHE_HOME is
+// not set), <hash> being the 64 bit FNV-1a of the host key in hex:
+//     autotune 1
+//     host <cpu model> | <n> cpus | L1d 48K L1i 32K L2 2048K L3 107520K
+//     task1.pipe_chunk 262144 0.00412
+// Calibration messages go to stderr.
+namespace Autotune {
+
+// Seconds taken by one calibration run with the knob set to Value.
+typedef std::function<double(long Value)> Measure;
+
+// Declares a knob. Register before Load, from one thread.
+void Register(const std::string& Name, long Default, const std::vector<long>& Candidates, Measure Run);
+// Tuned value of Name, Default when it is not tuned or tuning is off.
+long Get(const std::string& Name, long Default);
+// Loads this host's values, calibrates as described above (never when
+// MayCalibrate is false and Retune is not set) and saves. False if the
+// file could not be written.
+bool Load(bool Retune, bool MayCalibrate = true);
+// Path of the tuning file, empty when tuning is off.
+std::string FilePath();
+// CPU model, CPU count and cache sizes of this host.
+std::string HostKey();
+// 1, 2, 4, ... up to the number of CPUs, which is always included.
+std::vector<long> ThreadCandidates();
+
+} // namespace Autotune
+
+#endif // ifndef AUTOTUNE_HPP
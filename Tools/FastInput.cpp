@@ -0,0 +1,250 @@
+// Implementation file for FastInput - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "FastInput.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//==============================================================================
+
+namespace {
+
+const std::size_t BlockSize = 1 << 20;
+// Bytes ahead of a number within which it is parsed without first looking
+// for its end; only a longer token can reach the end of the buffer.
+const std::size_t NumberLength = 64;
+
+inline bool IsSpace(char c) { return static_cast<unsigned char>(c) <= ' '; }
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+// True when the eight bytes at Text are all digits.
+inline bool EightDigits(uint64_t Chunk) {
+    return ((Chunk & 0xF0F0F0F0F0F0F0F0ull) |
+            (((Chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+// Value of eight digit bytes, first byte most significant (little endian).
+inline uint32_t ParseEight(uint64_t Chunk) {
+    Chunk -= 0x3030303030303030ull;
+    Chunk = (Chunk * 10 + (Chunk >> 8)) & 0x00FF00FF00FF00FFull;
+    Chunk = (Chunk * 100 + (Chunk >> 16)) & 0x0000FFFF0000FFFFull;
+    return static_cast<uint32_t>(Chunk * 10000 + (Chunk >> 32));
+}
+
+// Digits from Text while there are, at most 19 (fits uint64).
+inline const char* ParseDigits(const char* Text, const char* End, uint64_t& Value, int& Count) {
+    while (End - Text >= 8 && Count + 8 <= 19) {
+        uint64_t Chunk;
+        std::memcpy(&Chunk, Text, 8);
+        if (!EightDigits(Chunk)) break;
+        Value = Value * 100000000 + ParseEight(Chunk);
+        Text += 8;
+        Count += 8;
+    }
+    while (Text < End && IsDigit(*Text) && Count < 19) {
+        Value = Value * 10 + (*Text++ - '0');
+        ++Count;
+    }
+    return Text;
+}
+
+const double Powers[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+} // namespace
+
+FastInput::FastInput(): Fd(-1), Buffer(nullptr), Capacity(0), Pos(nullptr), End(nullptr),
+    Mapped(nullptr), MappedLength(0), Eof(true) {}
+FastInput::~FastInput() { Close(); }
+
+bool FastInput::Open(int Descriptor) {
+    Close();
+    Fd = Descriptor;
+    struct stat Info;
+    if (fstat(Fd, &Info) == 0 && S_ISREG(Info.st_mode) && Info.st_size > 0) {
+        // Maps from the current offset (stdin may have been read already).
+        off_t Offset = lseek(Fd, 0, SEEK_CUR);
+        if (Offset >= 0 && Offset < Info.st_size) {
+            void* Map = mmap(nullptr, Info.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+            if (Map != MAP_FAILED) {
+                madvise(Map, Info.st_size, MADV_SEQUENTIAL);
+                Mapped = static_cast<const char*>(Map);
+                MappedLength = Info.st_size;
+                Pos = Mapped + Offset;
+                End = Mapped + MappedLength;
+                return true;
+            }
+        }
+    }
+    Buffer = static_cast<char*>(std::malloc(BlockSize));
+    if (Buffer == nullptr) return false;
+    Capacity = BlockSize;
+    Pos = End = Buffer;
+    Eof = false;
+    return true;
+}
+
+void FastInput::Close() {
+    if (Mapped != nullptr) munmap(const_cast<char*>(Mapped), MappedLength);
+    std::free(Buffer);
+    Fd = -1;
+    Buffer = nullptr;
+    Mapped = nullptr;
+    Capacity = MappedLength = 0;
+    Pos = End = nullptr;
+    Eof = true;
+}
+
+bool FastInput::Refill(std::size_t Keep) {
+    // Moves the last Keep bytes to the front and reads after them.
+    // Returns false when nothing more could be read.
+    if (Eof) return false;
+    const char* Kept = End - Keep;
+    if (Keep == Capacity) {
+        // A token longer than the buffer: grow it.
+        char* Bigger = static_cast<char*>(std::realloc(Buffer, Capacity * 2));
+        if (Bigger == nullptr) return false;
+        Kept = Bigger;
+        Buffer = Bigger;
+        Capacity *= 2;
+    }
+    std::memmove(Buffer, Kept, Keep);
+    ssize_t Got;
+    do {
+        Got = read(Fd, Buffer + Keep, Capacity - Keep);
+    } while (Got < 0 && errno == EINTR);
+    if (Got <= 0) Eof = true;
+    Pos = Buffer;
+    End = Buffer + Keep + (Got > 0 ? Got : 0);
+    return Got > 0;
+}
+
+bool FastInput::Ready(bool Whole) {
+    // Skips whitespace. The next token is then whole in the buffer, or (for
+    // numbers, Whole false) at least NumberLength bytes of it are.
+    while (true) {
+        while (Pos < End && IsSpace(*Pos)) ++Pos;
+        if (Pos == End) {
+            if (!Refill(0)) return false;
+            continue;
+        }
+        if (Eof || (!Whole && static_cast<std::size_t>(End - Pos) >= NumberLength)) return true;
+        const char* Token = Pos;
+        while (Token < End && !IsSpace(*Token)) ++Token;
+        if (Token < End) return true;
+        Refill(End - Pos);
+    }
+}
+
+bool FastInput::ReadInt(int64_t& Value) {
+    for (bool Whole = false; ; Whole = true) {
+        if (!Ready(Whole)) return false;
+        const char* Text = Pos;
+        bool Negative = (*Text == '-');
+        if (*Text == '-' || *Text == '+') ++Text;
+        uint64_t Magnitude = 0;
+        int Count = 0;
+        const char* Start = Text;
+        // Leading zeros are not significant, nor counted in the 19 digits.
+        while (Text < End && *Text == '0') ++Text;
+        const char* After = ParseDigits(Text, End, Magnitude, Count);
+        if (After == End && !Eof && !Whole) continue; // may go on past the buffer
+        if (After == Start) return false;
+        if (After < End && IsDigit(*After)) {
+            // 20 digits: one more if it still fits.
+            if (Magnitude > (UINT64_MAX - 9) / 10) return false;
+            Magnitude = Magnitude * 10 + (*After++ - '0');
+            if (After < End && IsDigit(*After)) return false;
+        }
+        if (After < End && !IsSpace(*After)) return false;
+        if (Magnitude > static_cast<uint64_t>(INT64_MAX) + Negative) return false;
+        Value = Negative ? static_cast<int64_t>(0 - Magnitude) : static_cast<int64_t>(Magnitude);
+        Pos = After;
+        return true;
+    }
+}
+
+bool FastInput::ReadDouble(double& Value) {
+    for (bool Whole = false; ; Whole = true) {
+        if (!Ready(Whole)) return false;
+        const char* Text = Pos;
+        bool Negative = (*Text == '-');
+        if (*Text == '-' || *Text == '+') ++Text;
+        uint64_t Mantissa = 0;
+        int Digits = 0, Exponent = 0;
+        const char* Start = Text;
+        // Leading zeros are not significant.
+        while (Text < End && *Text == '0') ++Text;
+        Text = ParseDigits(Text, End, Mantissa, Digits);
+        bool Exact = !(Text < End && IsDigit(*Text));
+        bool Any = Text > Start;
+        if (Text < End && *Text == '.') {
+            const char* Fraction = ++Text;
+            if (Digits == 0)
+                while (Text < End && *Text == '0') ++Text;
+            Text = ParseDigits(Text, End, Mantissa, Digits);
+            Exponent = -static_cast<int>(Text - Fraction);
+            if (Text < End && IsDigit(*Text)) Exact = false;
+            Any = Any || Text > Fraction;
+        }
+        if (Any && Text < End && (*Text == 'e' || *Text == 'E')) {
+            const char* Mark = Text++;
+            bool Minus = (Text < End && *Text == '-');
+            if (Text < End && (*Text == '-' || *Text == '+')) ++Text;
+            if (Text < End && IsDigit(*Text)) {
+                int Power = 0;
+                while (Text < End && IsDigit(*Text)) {
+                    if (Power < 100000) Power = Power * 10 + (*Text - '0');
+                    ++Text;
+                }
+                Exponent += Minus ? -Power : Power;
+            } else {
+                Text = Mark;
+            }
+        }
+        if (Text == End && !Eof && !Whole) continue; // may go on past the buffer
+        if (Any && Exact && (Text == End || IsSpace(*Text)) && Mantissa <= (1ull << 53) &&
+            Exponent >= -22 && Exponent <= 22) {
+            double Result = static_cast<double>(Mantissa);
+            Result = Exponent < 0 ? Result / Powers[-Exponent] : Result * Powers[Exponent];
+            Value = Negative ? -Result : Result;
+            Pos = Text;
+            return true;
+        }
+        // Everything else (long mantissas, big exponents, inf, nan) via strtod.
+        if (!Whole && !Eof) continue;
+        const char* Token = Pos;
+        while (Token < End && !IsSpace(*Token)) ++Token;
+        std::string Copy(Pos, Token - Pos);
+        char* Stop;
+        double Parsed = std::strtod(Copy.c_str(), &Stop);
+        if (Copy.empty() || Stop != Copy.c_str() + Copy.size()) return false;
+        Value = Parsed;
+        Pos = Token;
+        return true;
+    }
+}
+
+bool FastInput::ReadToken(const char*& Data, std::size_t& Size) {
+    if (!Ready(true)) return false;
+    const char* Token = Pos;
+    while (Token < End && !IsSpace(*Token)) ++Token;
+    Data = Pos;
+    Size = Token - Pos;
+    Pos = Token;
+    return true;
+}
+
+bool FastInput::ReadToken(std::string& Token) {
+    const char* Data;
+    std::size_t Size;
+    if (!ReadToken(Data, Size)) return false;
+    Token.assign(Data, Size);
+    return true;
+}
@@ -0,0 +1,51 @@
+// Header file of FastInput - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef FASTINPUT_HPP
+#define FASTINPUT_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <cstddef>
+#include <cstdint>
+//==============================================================================
+
+// Whitespace separated input, much faster than cin or scanf for bulk
+// numbers. A regular file (stdin redirected from one included) is mapped,
+// anything else (pipes, terminals) is read in 1 MiB blocks; a token never
+// straddles two blocks.
+// Integers are parsed eight digits at a time (SWAR). Doubles use the exact
+// fast path (at most 19 significant digits, power of ten up to 22) and fall
+// back to strtod, so every value is the correctly rounded one scanf gives.
+//     FastInput In;
+//     In.Open(0);
+//     int64_t n; while (In.ReadInt(n)) ...
+// The Read functions return false at the end of input or when the next
+// token is not of the asked kind (it is then left unread).
+class FastInput{
+    int Fd;
+    char* Buffer;
+    std::size_t Capacity;
+    const char* Pos;
+    const char* End;
+    const char* Mapped;
+    std::size_t MappedLength;
+    bool Eof;
+    bool Refill(std::size_t Keep);
+    bool Ready(bool Whole);
+ public:
+     FastInput();
+     FastInput(const FastInput&) = delete;
+     FastInput& operator=(const FastInput&) = delete;
+     ~FastInput();
+     // Reads from Fd (0 for stdin), which stays open. False on errors.
+     bool Open(int Descriptor);
+     void Close();
+     bool ReadInt(int64_t& Value);
+     bool ReadDouble(double& Value);
+     // The token stays valid until the next Read call.
+     bool ReadToken(const char*& Data, std::size_t& Size);
+     bool ReadToken(std::string& Token);
+};
+
+#endif // ifndef FASTINPUT_HPP
@@ -0,0 +1,111 @@
+// Implementation file for FileReader - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "FileReader.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//==============================================================================
+
+namespace {
+
+const char* const Names[ReadStrategies] = {
+    "buffered", "sequential", "willneed", "readahead", "direct", "map-seq", "map-willneed"
+};
+// O_DIRECT needs offsets, sizes and addresses aligned to the logical block.
+const std::size_t DirectAlign = 4096;
+
+} // namespace
+
+bool ParseReadStrategy(const std::string& Name, ReadStrategy& Strategy) {
+    for (int s = 0; s < ReadStrategies; ++s)
+        if (Name == Names[s]) {
+            Strategy = static_cast<ReadStrategy>(s);
+            return true;
+        }
+    return false;
+}
+
+const char* ReadStrategyName(ReadStrategy Strategy) {
+    return Names[static_cast<int>(Strategy)];
+}
+
+FileReader::FileReader(): Fd(-1), Using(DefaultReadStrategy), Buffer(nullptr),
+    BufferBytes(0), Length(0), Position(0), Failed(false) {}
+FileReader::~FileReader() { Close(); }
+
+bool FileReader::Open(const std::string& FilePath, ReadStrategy Strategy, std::size_t Bytes) {
+    // Returns false if the file can not be opened or mapped.
+    Close();
+    Using = Strategy;
+    BufferBytes = Bytes < DirectAlign ? DirectAlign : Bytes;
+    if (Strategy == ReadStrategy::MapSequential || Strategy == ReadStrategy::MapWillNeed) {
+        if (!Map.Open(FilePath)) return false;
+        Length = Map.Size();
+        Map.Advise(Strategy == ReadStrategy::MapSequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        return true;
+    }
+    if (Strategy == ReadStrategy::Direct) {
+        Fd = open(FilePath.c_str(), O_RDONLY | O_DIRECT);
+        if (Fd < 0 && errno == EINVAL) Using = ReadStrategy::Buffered; // tmpfs and friends
+        BufferBytes = (BufferBytes + DirectAlign - 1) / DirectAlign * DirectAlign;
+    }
+    if (Fd < 0) Fd = open(FilePath.c_str(), O_RDONLY);
+    if (Fd < 0) return false;
+    struct stat Info;
+    if (fstat(Fd, &Info) == 0) Length = static_cast<std::size_t>(Info.st_size);
+    void* Memory = nullptr;
+    if (posix_memalign(&Memory, DirectAlign, BufferBytes) != 0) {
+        Close();
+        return false;
+    }
+    Buffer = static_cast<char*>(Memory);
+    if (Using == ReadStrategy::Sequential) posix_fadvise(Fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    else if (Using == ReadStrategy::WillNeed) posix_fadvise(Fd, 0, 0, POSIX_FADV_WILLNEED);
+    else if (Using == ReadStrategy::Readahead) readahead(Fd, 0, Length);
+    return true;
+}
+
+void FileReader::Close() {
+    if (Fd >= 0) close(Fd);
+    free(Buffer);
+    Map.Close();
+    Fd = -1;
+    Buffer = nullptr;
+    Length = Position = 0;
+    Failed = false;
+}
+
+bool FileReader::Next(const char*& Data, std::size_t& Size) {
+    if (Map.IsOpen()) {
+        if (Position >= Length) return false;
+        Data = Map.Data() + Position;
+        Size = (Length - Position < BufferBytes) ? Length - Position : BufferBytes;
+        Position += Size;
+        return true;
+    }
+    if (Fd < 0) return false;
+    ssize_t Got;
+    do {
+        Got = read(Fd, Buffer, BufferBytes);
+    } while (Got < 0 && errno == EINTR);
+    if (Got < 0) Failed = true;
+    if (Got <= 0) return false;
+    Data = Buffer;
+    Size = static_cast<std::size_t>(Got);
+    Position += Size;
+    return true;
+}
+
+bool FileReader::DropCache(const std::string& FilePath) {
+    int File = open(FilePath.c_str(), O_RDONLY);
+    if (File < 0) return false;
+    // Dirty pages can not be dropped, write them back first.
+    fdatasync(File);
+    bool Dropped = posix_fadvise(File, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(File);
+    return Dropped;
+}
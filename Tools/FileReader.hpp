@@ -0,0 +1,72 @@
+// Header file of FileReader - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef FILEREADER_HPP
+#define FILEREADER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <cstddef>
+#include "MappedFile.hpp"
+//==============================================================================
+
+// How a file is read front to back.
+//   Buffered      : plain read() into the buffer.
+//   Sequential    : read() after posix_fadvise(SEQUENTIAL), bigger readahead.
+//   WillNeed      : read() after posix_fadvise(WILLNEED) of the whole file.
+//   Readahead     : read() after readahead() of the whole file.
+//   Direct        : O_DIRECT into an aligned buffer, bypasses the page cache
+//                   (falls back to Buffered where O_DIRECT is refused).
+//   MapSequential : mmap with madvise(MADV_SEQUENTIAL).
+//   MapWillNeed   : mmap with madvise(MADV_WILLNEED).
+enum class ReadStrategy {
+    Buffered, Sequential, WillNeed, Readahead, Direct, MapSequential, MapWillNeed
+};
+const int ReadStrategies = 7;
+
+// Chosen from File_IO/read_bench (numbers in its header): read() with
+// fadvise(SEQUENTIAL) and 1 MiB chunks was at or near the top cold and
+// warm, and unlike the mapped strategies it works on pipes too.
+const ReadStrategy DefaultReadStrategy = ReadStrategy::Sequential;
+const std::size_t DefaultReadBuffer = 1 << 20;
+
+// "buffered", "sequential", "willneed", "readahead", "direct", "map-seq",
+// "map-willneed". False for anything else.
+bool ParseReadStrategy(const std::string& Name, ReadStrategy& Strategy);
+const char* ReadStrategyName(ReadStrategy Strategy);
+
+// Streams a file in chunks:
+//     FileReader Reader;
+//     if (!Reader.Open(Path)) ...
+//     const char* Data; std::size_t Size;
+//     while (Reader.Next(Data, Size)) Consume(Data, Size);
+// A chunk stays valid until the next call. Mapped strategies hand out the
+// mapping itself, Buffer bytes at a time.
+class FileReader{
+    int Fd;
+    ReadStrategy Using;
+    char* Buffer;
+    std::size_t BufferBytes;
+    std::size_t Length, Position;
+    MappedFile Map;
+    bool Failed;
+ public:
+     FileReader();
+     FileReader(const FileReader&) = delete;
+     FileReader& operator=(const FileReader&) = delete;
+     ~FileReader();
+     bool Open(const std::string& FilePath,
+               ReadStrategy Strategy = DefaultReadStrategy,
+               std::size_t Buffer = DefaultReadBuffer);
+     void Close();
+     bool Next(const char*& Data, std::size_t& Size);
+     // False when a read failed before the end of the file.
+     bool Good() const { return !Failed; }
+     std::size_t Size() const { return Length; }
+     // The strategy actually used (after fallbacks).
+     ReadStrategy Strategy() const { return Using; }
+     // Drops the file's clean pages from the page cache, for cold reads.
+     static bool DropCache(const std::string& FilePath);
+};
+
+#endif // ifndef FILEREADER_HPP
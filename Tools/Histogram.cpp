@@ -0,0 +1,144 @@
+// Implementation file for Histogram - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Histogram.hpp"
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+//==============================================================================
+
+namespace {
+
+const uint64_t SubCount = uint64_t(1) << Histogram::SubBits;
+const uint64_t SubMask = SubCount - 1;
+
+void StoreMin(std::atomic<uint64_t>& Target, uint64_t Value) {
+    uint64_t Current = Target.load(std::memory_order_relaxed);
+    while (Value < Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed)) {}
+}
+
+void StoreMax(std::atomic<uint64_t>& Target, uint64_t Value) {
+    uint64_t Current = Target.load(std::memory_order_relaxed);
+    while (Value > Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed)) {}
+}
+
+} // namespace
+
+Histogram::Histogram() { Reset(); }
+
+int Histogram::BucketOf(uint64_t Value) {
+    if (Value < SubCount) return Value;
+    int Shift = 63 - __builtin_clzll(Value) - SubBits;
+    return ((Shift + 1) << SubBits) | ((Value >> Shift) & SubMask);
+}
+
+uint64_t Histogram::LowestOf(int Bucket) {
+    if (Bucket < static_cast<int>(SubCount)) return Bucket;
+    int Shift = (Bucket >> SubBits) - 1;
+    return (SubCount + (Bucket & SubMask)) << Shift;
+}
+
+uint64_t Histogram::HighestOf(int Bucket) {
+    if (Bucket < static_cast<int>(SubCount)) return Bucket;
+    int Shift = (Bucket >> SubBits) - 1;
+    return LowestOf(Bucket) + ((uint64_t(1) << Shift) - 1);
+}
+
+void Histogram::Record(uint64_t Value) {
+    Counts[BucketOf(Value)].fetch_add(1, std::memory_order_relaxed);
+    Total.fetch_add(1, std::memory_order_relaxed);
+    Sum.fetch_add(Value, std::memory_order_relaxed);
+    StoreMin(Min, Value);
+    StoreMax(Max, Value);
+}
+
+void Histogram::Merge(const Histogram& Other) {
+    for (int b = 0; b < Buckets; ++b) {
+        uint64_t Count = Other.Counts[b].load(std::memory_order_relaxed);
+        if (Count != 0) Counts[b].fetch_add(Count, std::memory_order_relaxed);
+    }
+    Total.fetch_add(Other.Count(), std::memory_order_relaxed);
+    Sum.fetch_add(Other.Sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    StoreMin(Min, Other.Min.load(std::memory_order_relaxed));
+    StoreMax(Max, Other.Max.load(std::memory_order_relaxed));
+}
+
+void Histogram::Reset() {
+    for (std::atomic<uint64_t>& Count : Counts) Count.store(0, std::memory_order_relaxed);
+    Total.store(0);
+    Sum.store(0);
+    Min.store(UINT64_MAX);
+    Max.store(0);
+}
+
+uint64_t Histogram::Minimum() const {
+    return (Count() == 0) ? 0 : Min.load(std::memory_order_relaxed);
+}
+
+double Histogram::Mean() const {
+    return (Count() == 0) ? 0.0 : static_cast<double>(Sum.load()) / Count();
+}
+
+uint64_t Histogram::Percentile(double Percent) const {
+    const uint64_t Count = this->Count();
+    if (Count == 0) return 0;
+    uint64_t Rank = static_cast<uint64_t>(std::ceil(Percent / 100.0 * Count));
+    if (Rank == 0) Rank = 1;
+    uint64_t Seen = 0;
+    for (int b = 0; b < Buckets; ++b) {
+        Seen += Counts[b].load(std::memory_order_relaxed);
+        if (Seen >= Rank) return std::min(HighestOf(b), Maximum());
+    }
+    return Maximum();
+}
+
+void Histogram::Print(const char* Label, const char* Unit) const {
+    printf("%s: n=%llu mean %.1f p50 %llu p99 %llu p99.9 %llu max %llu %s\n", Label,
+           static_cast<unsigned long long>(Count()), Mean(),
+           static_cast<unsigned long long>(Percentile(50.0)),
+           static_cast<unsigned long long>(Percentile(99.0)),
+           static_cast<unsigned long long>(Percentile(99.9)),
+           static_cast<unsigned long long>(Maximum()), Unit);
+}
+
+void Histogram::Serialize(std::ostream& Out) const {
+    Out << "histogram " << SubBits << ' ' << Count() << ' ' << Sum.load() << ' '
+        << Minimum() << ' ' << Maximum() << '\n';
+    for (int b = 0; b < Buckets; ++b) {
+        uint64_t Count = Counts[b].load(std::memory_order_relaxed);
+        if (Count != 0) Out << b << ' ' << Count << '\n';
+    }
+    Out << "end\n";
+}
+
+bool Histogram::Deserialize(std::istream& In) {
+    std::string Word;
+    int Bits;
+    uint64_t Count, Total, Sum, Min, Max;
+    if (!(In >> Word >> Bits >> Total >> Sum >> Min >> Max) || Word != "histogram" || Bits != SubBits)
+        return false;
+    // Everything is checked before the counts are added.
+    std::vector<std::pair<int, uint64_t> > Used;
+    uint64_t Checked = 0;
+    int Bucket;
+    while (In >> Word && Word != "end") {
+        if (Word.find_first_not_of("0123456789") != std::string::npos || Word.size() > 5) return false;
+        Bucket = std::stoi(Word);
+        if (!(In >> Count) || Bucket >= Buckets) return false;
+        Used.emplace_back(Bucket, Count);
+        Checked += Count;
+    }
+    if (Word != "end" || Checked != Total) return false;
+    for (const std::pair<int, uint64_t>& B : Used)
+        Counts[B.first].fetch_add(B.second, std::memory_order_relaxed);
+    this->Total.fetch_add(Total, std::memory_order_relaxed);
+    this->Sum.fetch_add(Sum, std::memory_order_relaxed);
+    if (Total != 0) {
+        StoreMin(this->Min, Min);
+        StoreMax(this->Max, Max);
+    }
+    return true;
+}
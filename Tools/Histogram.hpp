@@ -0,0 +1,57 @@
+// Header file of Histogram - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+//==============================================================================
+
+// Latency histogram with log-linear buckets (HdrHistogram layout): values
+// below 2^SubBits have their own bucket, above that every power of two is
+// cut in 2^SubBits equal buckets, so any value is known within 1/128 over
+// the whole uint64_t range with a fixed 7424-bucket table.
+// Record is O(1) and lock free (relaxed atomic increments), so threads may
+// share one histogram; the usual pattern is still one per thread, merged
+// once the threads are joined.
+class Histogram{
+ public:
+     static const int SubBits = 7;
+     static const int Buckets = (65 - SubBits) << SubBits;
+ private:
+     std::atomic<uint64_t> Counts[Buckets];
+     std::atomic<uint64_t> Total, Sum, Min, Max;
+ public:
+     Histogram();
+     Histogram(const Histogram&) = delete;
+     Histogram& operator=(const Histogram&) = delete;
+     static int BucketOf(uint64_t Value);
+     // Smallest and largest values that fall in a bucket.
+     static uint64_t LowestOf(int Bucket);
+     static uint64_t HighestOf(int Bucket);
+
+     void Record(uint64_t Value);
+     void Merge(const Histogram& Other);
+     void Reset();
+     uint64_t Count() const { return Total.load(std::memory_order_relaxed); }
+     uint64_t Minimum() const;
+     uint64_t Maximum() const { return Max.load(std::memory_order_relaxed); }
+     double Mean() const;
+     // Value below which Percent % of the recorded values are (bucket upper
+     // bound, never above Maximum). 0 when empty.
+     uint64_t Percentile(double Percent) const;
+     // Prints "<Label>: n=... p50 ... p99 ... p99.9 ... max ..." in Unit
+     // ("ns" values are shown as recorded).
+     void Print(const char* Label, const char* Unit = "ns") const;
+
+     // Text form: a header line then one "bucket count" line per used bucket.
+     void Serialize(std::ostream& Out) const;
+     // Adds a serialized histogram to this one. False on a malformed input.
+     bool Deserialize(std::istream& In);
+};
+
+#endif // ifndef HISTOGRAM_HPP
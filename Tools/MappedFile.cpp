@@ -0,0 +1,48 @@
+// Implementation file for MappedFile - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//==============================================================================
+
+MappedFile::MappedFile(): Fd(-1), Base(nullptr), Length(0) {}
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string& FilePath) {
+    // Maps the file read-only. Returns false if it can not be opened.
+    Close();
+    Fd = open(FilePath.c_str(), O_RDONLY);
+    if (Fd < 0) return false;
+
+    struct stat Info;
+    if (fstat(Fd, &Info) != 0) {
+        Close();
+        return false;
+    }
+    Length = static_cast<std::size_t>(Info.st_size);
+    if (Length == 0) return true; // Nothing to map, empty file is valid.
+
+    void* Map = mmap(nullptr, Length, PROT_READ, MAP_PRIVATE, Fd, 0);
+    if (Map == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    Base = static_cast<const char*>(Map);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (Base != nullptr) munmap(const_cast<char*>(Base), Length);
+    if (Fd >= 0) close(Fd);
+    Fd = -1;
+    Base = nullptr;
+    Length = 0;
+}
+
+bool MappedFile::Advise(int Advice) const {
+    if (Base == nullptr) return Length == 0 && Fd >= 0;
+    return madvise(const_cast<char*>(Base), Length, Advice) == 0;
+}
@@ -0,0 +1,34 @@
+// Header file of MappedFile - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <cstddef>
+//==============================================================================
+
+// Read-only memory mapping of a whole file.
+// The descriptor is kept open so callers can also use it for
+// copy_file_range/sendfile on the same file.
+class MappedFile{
+    int Fd;
+    const char* Base;
+    std::size_t Length;
+ public:
+     MappedFile();
+     MappedFile(const MappedFile&) = delete;
+     MappedFile& operator=(const MappedFile&) = delete;
+     bool Open(const std::string& FilePath);
+     void Close();
+     bool IsOpen() const { return Fd >= 0; }
+     const char* Data() const { return Base; }
+     std::size_t Size() const { return Length; }
+     int Descriptor() const { return Fd; }
+     // madvise() over the whole mapping (MADV_SEQUENTIAL, MADV_WILLNEED...).
+     bool Advise(int Advice) const;
+     ~MappedFile();
+};
+
+#endif // ifndef MAPPEDFILE_HPP
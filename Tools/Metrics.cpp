@@ -0,0 +1,119 @@
+// Implementation file for Metrics - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Metrics.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+//==============================================================================
+
+// Builds embedded in other processes (the library) define it to 0.
+#ifndef METRICS_SHARED
+#define METRICS_SHARED 1
+#endif
+
+namespace Metrics {
+namespace {
+
+std::mutex Registering;
+Region* Shared = nullptr;
+char SharedPath[64] = "";
+Slot Spare; // handed out when the region is full
+
+void RemoveFile() {
+    if (SharedPath[0] != '\0') unlink(SharedPath);
+}
+
+bool WantShared() {
+    // TASK_METRICS=0 / 1 overrides the default of the build.
+    const char* Setting = std::getenv("TASK_METRICS");
+    if (Setting != nullptr && Setting[0] != '\0') return Setting[0] != '0';
+    return METRICS_SHARED != 0;
+}
+
+Region* Create() {
+    // The shared file, or private memory when /dev/shm is not usable or
+    // not wanted. The file is made under a hidden name and locked before
+    // it is renamed into place: the lock, held for the life of the process
+    // (the descriptor is never closed), tells metrics-top the app is alive.
+    std::snprintf(SharedPath, sizeof(SharedPath), "/dev/shm/metrics.%d", static_cast<int>(getpid()));
+    char Making[sizeof(SharedPath)];
+    std::snprintf(Making, sizeof(Making), "/dev/shm/.metrics.%d", static_cast<int>(getpid()));
+    void* Map = MAP_FAILED;
+    int Fd = WantShared() ? open(Making, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : -1;
+    if (Fd >= 0 && flock(Fd, LOCK_EX | LOCK_NB) == 0 && ftruncate(Fd, sizeof(Region)) == 0)
+        Map = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    if (Map == MAP_FAILED) {
+        if (Fd >= 0) {
+            unlink(Making);
+            close(Fd);
+        }
+        SharedPath[0] = '\0';
+        Map = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (Map == MAP_FAILED) return nullptr;
+    }
+    // The file is zero filled, the atomics start at 0.
+    Region* Memory = static_cast<Region*>(Map);
+    Header& Head = Memory->Head;
+    Head.Pid = getpid();
+    Head.Slots = Capacity;
+    timespec Now;
+    clock_gettime(CLOCK_REALTIME, &Now);
+    Head.StartNs = static_cast<uint64_t>(Now.tv_sec) * 1000000000ull + Now.tv_nsec;
+    FILE* Comm = std::fopen("/proc/self/comm", "r");
+    if (Comm != nullptr) {
+        if (std::fgets(Head.Program, sizeof(Head.Program), Comm) != nullptr)
+            Head.Program[std::strcspn(Head.Program, "\n")] = '\0';
+        std::fclose(Comm);
+    }
+    // The tag last: readers ignore a file until it is there.
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(Head.Tag, Magic, sizeof(Magic));
+    if (SharedPath[0] != '\0') {
+        if (rename(Making, SharedPath) == 0) {
+            std::atexit(RemoveFile);
+        } else {
+            // Still counted in this process, just not visible outside.
+            unlink(Making);
+            SharedPath[0] = '\0';
+        }
+    }
+    return Memory;
+}
+
+} // namespace
+
+Slot* Register(const char* Name, Kind Type) {
+    std::lock_guard<std::mutex> Guard(Registering);
+    if (Shared == nullptr) Shared = Create();
+    if (Shared == nullptr) return &Spare;
+    Header& Head = Shared->Head;
+    const uint32_t Count = Head.Count.load(std::memory_order_relaxed);
+    for (uint32_t s = 0; s < Count; ++s)
+        if (std::strncmp(Shared->Slots[s].Name, Name, sizeof(Slot::Name) - 1) == 0)
+            return &Shared->Slots[s];
+    if (Count == Capacity) return &Spare;
+
+    Slot& New = Shared->Slots[Count];
+    const uint32_t Sequence = Head.Sequence.load(std::memory_order_relaxed);
+    Head.Sequence.store(Sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::strncpy(New.Name, Name, sizeof(New.Name) - 1);
+    New.Type = static_cast<uint32_t>(Type);
+    Head.Count.store(Count + 1, std::memory_order_relaxed);
+    Head.Sequence.store(Sequence + 2, std::memory_order_release);
+    return &New;
+}
+
+const char* Path() {
+    std::lock_guard<std::mutex> Guard(Registering);
+    return SharedPath;
+}
+
+} // namespace Metrics
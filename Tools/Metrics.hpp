@@ -0,0 +1,98 @@
+// Header file of Metrics - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+//==============================================================================
+
+// Live metrics of a running app, readable from outside with metrics-top.
+// The first metric created maps /dev/shm/metrics.<pid>, locked with flock
+// for the life of the app (removed at exit, or by metrics-top once the
+// lock is free after a crash or a signal);
+// every metric is one 64 byte slot of it, so updates from different
+// metrics never share a cache line:
+//     static Metrics::Counter Rows("task1.rows_read");
+//     Rows.Add();                       // one relaxed atomic add
+// Counter and Gauge are single words, the reader can not see them torn.
+// Progress is two words (done, total) published with a seqlock, one writer
+// at a time. Registration (name and kind of a new slot) is published with
+// the seqlock of the header, so a reader never sees a half written name.
+// When /dev/shm can not be used the metrics live in private memory, as
+// they do with TASK_METRICS=0 or in builds with METRICS_SHARED=0 (the
+// library, where TASK_METRICS=1 turns the file on).
+namespace Metrics {
+
+enum class Kind : uint32_t { Counter = 1, Gauge = 2, Progress = 3 };
+
+const uint32_t Capacity = 127;
+const char Magic[8] = {'m', 'e', 't', 'r', 'i', 'c', 's', '1'};
+
+struct alignas(64) Slot{
+    std::atomic<uint64_t> Value;
+    std::atomic<uint64_t> Total;       // Progress only
+    std::atomic<uint32_t> Sequence;    // Progress only, odd while writing
+    uint32_t Type;                     // Kind
+    char Name[40];
+};
+
+struct alignas(64) Header{
+    char Tag[8];                       // Magic
+    std::atomic<uint32_t> Sequence;    // odd while a slot is registered
+    std::atomic<uint32_t> Count;
+    int32_t Pid;
+    uint32_t Slots;                    // Capacity
+    uint64_t StartNs;                  // CLOCK_REALTIME at creation
+    char Program[32];
+};
+
+struct Region{
+    Header Head;
+    Slot Slots[Capacity];
+};
+
+// The slot named Name, registered with Type if it is new (names longer
+// than 39 characters are cut). Never null.
+Slot* Register(const char* Name, Kind Type);
+// Path of the shared file, empty if metrics are private.
+const char* Path();
+
+class Counter{
+    Slot* Cell;
+ public:
+     explicit Counter(const char* Name): Cell(Register(Name, Kind::Counter)) {}
+     void Add(uint64_t N = 1) { Cell->Value.fetch_add(N, std::memory_order_relaxed); }
+};
+
+class Gauge{
+    Slot* Cell;
+ public:
+     explicit Gauge(const char* Name): Cell(Register(Name, Kind::Gauge)) {}
+     void Set(double V) {
+         uint64_t Bits;
+         std::memcpy(&Bits, &V, sizeof(Bits));
+         Cell->Value.store(Bits, std::memory_order_relaxed);
+     }
+};
+
+class Progress{
+    Slot* Cell;
+ public:
+     explicit Progress(const char* Name): Cell(Register(Name, Kind::Progress)) {}
+     void Set(uint64_t Done, uint64_t Total) {
+         uint32_t Sequence = Cell->Sequence.load(std::memory_order_relaxed);
+         Cell->Sequence.store(Sequence + 1, std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_release);
+         Cell->Value.store(Done, std::memory_order_relaxed);
+         Cell->Total.store(Total, std::memory_order_relaxed);
+         Cell->Sequence.store(Sequence + 2, std::memory_order_release);
+     }
+};
+
+} // namespace Metrics
+
+#endif // ifndef METRICS_HPP
@@ -0,0 +1,189 @@
+// metrics-top: live view of the metrics of running apps (see Metrics.hpp).
+// Only reads /dev/shm/metrics.<pid>: the apps do nothing to be sampled.
+// Usage: ./metrics-top [-i ms] [-n samples] [pid]
+// Counters are shown with their rate since the previous sample.
+//==============================================================================
+#include "Metrics.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//==============================================================================
+
+namespace {
+
+struct Reading{
+    std::string Name;
+    Metrics::Kind Type;
+    uint64_t Value, Total;
+};
+
+// Registry under the header seqlock, Progress under the slot seqlock.
+void Sample(const Metrics::Region& Memory, std::vector<Reading>& Readings) {
+    const Metrics::Header& Head = Memory.Head;
+    for (int Attempt = 0; Attempt < 1000; ++Attempt) {
+        const uint32_t Before = Head.Sequence.load(std::memory_order_acquire);
+        if (Before & 1) continue;
+        uint32_t Count = Head.Count.load(std::memory_order_relaxed);
+        if (Count > Metrics::Capacity) Count = Metrics::Capacity;
+        Readings.resize(Count);
+        for (uint32_t s = 0; s < Count; ++s) {
+            char Name[sizeof(Metrics::Slot::Name)];
+            std::memcpy(Name, Memory.Slots[s].Name, sizeof(Name));
+            Name[sizeof(Name) - 1] = '\0';
+            Readings[s].Name = Name;
+            Readings[s].Type = static_cast<Metrics::Kind>(Memory.Slots[s].Type);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Head.Sequence.load(std::memory_order_relaxed) == Before) break;
+    }
+    for (std::size_t s = 0; s < Readings.size(); ++s) {
+        const Metrics::Slot& Cell = Memory.Slots[s];
+        if (Readings[s].Type != Metrics::Kind::Progress) {
+            Readings[s].Value = Cell.Value.load(std::memory_order_relaxed);
+            continue;
+        }
+        for (int Attempt = 0; Attempt < 1000; ++Attempt) {
+            const uint32_t Before = Cell.Sequence.load(std::memory_order_acquire);
+            if (Before & 1) continue;
+            Readings[s].Value = Cell.Value.load(std::memory_order_relaxed);
+            Readings[s].Total = Cell.Total.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (Cell.Sequence.load(std::memory_order_relaxed) == Before) break;
+        }
+    }
+}
+
+// Read-only mapping of a metrics file, null if it is not one (yet). A
+// file shorter than a Region (just created, or not ours) would raise
+// SIGBUS on the first read past its end.
+const Metrics::Region* Map(const std::string& Path) {
+    int Fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (Fd < 0) return nullptr;
+    struct stat Info;
+    if (fstat(Fd, &Info) != 0 || Info.st_size < static_cast<off_t>(sizeof(Metrics::Region))) {
+        close(Fd);
+        return nullptr;
+    }
+    void* Memory = mmap(nullptr, sizeof(Metrics::Region), PROT_READ, MAP_SHARED, Fd, 0);
+    close(Fd);
+    if (Memory == MAP_FAILED) return nullptr;
+    const Metrics::Region* Region = static_cast<const Metrics::Region*>(Memory);
+    if (std::memcmp(Region->Head.Tag, Metrics::Magic, sizeof(Metrics::Magic)) != 0) {
+        munmap(Memory, sizeof(Metrics::Region));
+        return nullptr;
+    }
+    return Region;
+}
+
+// Removes Path if its app is gone: the app holds a flock on it while it
+// runs. The pid is no sign of life, /dev/shm may be shared by processes
+// of other pid namespaces (containers with --ipc=host).
+bool RemoveIfStale(const std::string& Path) {
+    int Fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (Fd < 0) return false;
+    bool Stale = false;
+    if (flock(Fd, LOCK_EX | LOCK_NB) == 0) {
+        // Only if the path is still this file, not a new one renamed over it.
+        struct stat Locked, Named;
+        Stale = fstat(Fd, &Locked) == 0 && stat(Path.c_str(), &Named) == 0 &&
+                Locked.st_dev == Named.st_dev && Locked.st_ino == Named.st_ino;
+        if (Stale) unlink(Path.c_str());
+    }
+    close(Fd);
+    return Stale;
+}
+
+std::vector<std::string> Files(int Pid) {
+    std::vector<std::string> Found;
+    if (Pid > 0) {
+        Found.push_back("/dev/shm/metrics." + std::to_string(Pid));
+        return Found;
+    }
+    DIR* Folder = opendir("/dev/shm");
+    if (Folder == nullptr) return Found;
+    while (dirent* Entry = readdir(Folder))
+        if (std::strncmp(Entry->d_name, "metrics.", 8) == 0)
+            Found.push_back(std::string("/dev/shm/") + Entry->d_name);
+    closedir(Folder);
+    return Found;
+}
+
+} // namespace
+
+int main(int args, char** argv) {
+    int IntervalMs = 1000, Samples = -1, Pid = 0;
+    for (int i = 1; i < args; ++i) {
+        if (std::strcmp(argv[i], "-i") == 0 && i + 1 < args) IntervalMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < args) Samples = std::atoi(argv[++i]);
+        else if (argv[i][0] != '-') Pid = std::atoi(argv[i]);
+        else {
+            printf("Usage: metrics-top [-i ms] [-n samples] [pid]\n");
+            return EXIT_FAILURE;
+        }
+    }
+    const bool Screen = isatty(STDOUT_FILENO);
+    // Previous counter values, by "pid/slot".
+    std::map<std::string, uint64_t> Previous;
+    auto Last = std::chrono::steady_clock::now();
+    for (int Round = 0; Samples < 0 || Round < Samples; ++Round) {
+        if (Round > 0) std::this_thread::sleep_for(std::chrono::milliseconds(IntervalMs));
+        auto Now = std::chrono::steady_clock::now();
+        const double Seconds = std::chrono::duration<double>(Now - Last).count();
+        Last = Now;
+        if (Screen) printf("\033[H\033[2J");
+        timespec Wall;
+        clock_gettime(CLOCK_REALTIME, &Wall);
+        const uint64_t WallNs = static_cast<uint64_t>(Wall.tv_sec) * 1000000000ull + Wall.tv_nsec;
+        int Shown = 0;
+        for (const std::string& Path : Files(Pid)) {
+            // Files of killed or crashed apps (no atexit) are removed.
+            if (RemoveIfStale(Path)) continue;
+            const Metrics::Region* Memory = Map(Path);
+            if (Memory == nullptr) continue;
+            const Metrics::Header& Head = Memory->Head;
+            std::vector<Reading> Readings;
+            Sample(*Memory, Readings);
+            char Program[sizeof(Head.Program) + 1] = {};
+            std::memcpy(Program, Head.Program, sizeof(Head.Program));
+            printf("%s  pid %d  up %.1f s\n", Program, Head.Pid, (WallNs - Head.StartNs) / 1e9);
+            for (std::size_t s = 0; s < Readings.size(); ++s) {
+                const Reading& R = Readings[s];
+                printf("  %-40s", R.Name.c_str());
+                if (R.Type == Metrics::Kind::Counter) {
+                    const std::string Key = std::to_string(Head.Pid) + "/" + std::to_string(s);
+                    auto Seen = Previous.find(Key);
+                    printf(" %16llu", static_cast<unsigned long long>(R.Value));
+                    if (Seen != Previous.end() && Round > 0)
+                        printf(" %14.0f/s", (R.Value - Seen->second) / Seconds);
+                    Previous[Key] = R.Value;
+                } else if (R.Type == Metrics::Kind::Gauge) {
+                    double Value;
+                    std::memcpy(&Value, &R.Value, sizeof(Value));
+                    printf(" %16.6g", Value);
+                } else {
+                    printf(" %16llu / %llu", static_cast<unsigned long long>(R.Value),
+                           static_cast<unsigned long long>(R.Total));
+                    if (R.Total > 0) printf(" (%.1f%%)", 100.0 * R.Value / R.Total);
+                }
+                printf("\n");
+            }
+            munmap(const_cast<Metrics::Region*>(Memory), sizeof(Metrics::Region));
+            ++Shown;
+        }
+        if (Shown == 0) printf("No running app with metrics.\n");
+        fflush(stdout);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,269 @@
+// Implementation file for MicroBench - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "MicroBench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sched.h>
+//==============================================================================
+
+namespace MicroBench {
+
+namespace {
+
+struct Entry{
+    std::string Name;
+    Function Run;
+    int64_t Arg;
+};
+
+std::vector<Entry>& Registry() {
+    static std::vector<Entry> Entries;
+    return Entries;
+}
+
+struct Options{
+    std::string Filter, Out, CompareA, CompareB;
+    int Samples = 20;
+    double MinTime = 0.02;   // seconds per sample
+    double Threshold = 0.02; // relative change considered significant
+    int Pin = -1;
+};
+
+std::string ReadLine(const char* Path) {
+    std::ifstream File(Path);
+    std::string Line;
+    std::getline(File, Line);
+    return Line;
+}
+
+// Warns about what makes timings unstable: frequency scaling and a process
+// free to migrate between cores.
+void CheckMachine(const Options& Opt) {
+#ifndef __OPTIMIZE__
+    printf("Warning: built without optimization, timings say little "
+           "(configure with -DCMAKE_BUILD_TYPE=Release).\n");
+#endif
+    std::string Governor = ReadLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    if (!Governor.empty() && Governor != "performance")
+        printf("Warning: CPU governor is '%s', frequency scaling adds noise "
+               "(set it to 'performance').\n", Governor.c_str());
+    std::string Turbo = ReadLine("/sys/devices/system/cpu/intel_pstate/no_turbo");
+    if (Turbo == "0") printf("Warning: turbo boost is on, clock speed depends on temperature.\n");
+    std::string Current = ReadLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq");
+    std::string Maximum = ReadLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_max_freq");
+    if (!Current.empty() && !Maximum.empty())
+        printf("CPU0 at %s of %s kHz.\n", Current.c_str(), Maximum.c_str());
+
+    cpu_set_t Set;
+    if (Opt.Pin >= 0) {
+        CPU_ZERO(&Set);
+        CPU_SET(Opt.Pin, &Set);
+        if (sched_setaffinity(0, sizeof(Set), &Set) != 0)
+            printf("Warning: cannot pin to CPU %d.\n", Opt.Pin);
+        else
+            printf("Pinned to CPU %d.\n", Opt.Pin);
+    } else if (sched_getaffinity(0, sizeof(Set), &Set) == 0 && CPU_COUNT(&Set) > 1) {
+        printf("Warning: not pinned (%d CPUs allowed), use --pin=<cpu>.\n", CPU_COUNT(&Set));
+    }
+}
+
+double RunOnce(const Entry& E, uint64_t Iterations) {
+    State S(Iterations, E.Arg);
+    E.Run(S);
+    return S.Seconds();
+}
+
+Result Measure(const Entry& E, const Options& Opt) {
+    // Calibration: grow the iteration count until one sample is long enough.
+    uint64_t Iterations = 1;
+    while (true) {
+        double Time = RunOnce(E, Iterations);
+        if (Time >= Opt.MinTime || Iterations >= (uint64_t(1) << 40)) break;
+        double Factor = (Time > 0) ? 1.4 * Opt.MinTime / Time : 100.0;
+        Factor = std::min(100.0, std::max(2.0, Factor));
+        Iterations = static_cast<uint64_t>(Iterations * Factor);
+    }
+    Result R{E.Name, Iterations, {}};
+    for (int s = 0; s < Opt.Samples; ++s)
+        R.Samples.push_back(RunOnce(E, Iterations) * 1e9 / Iterations);
+    return R;
+}
+
+std::string Human(double Nanoseconds) {
+    char Text[32];
+    if (Nanoseconds < 1e3) snprintf(Text, sizeof(Text), "%.2f ns", Nanoseconds);
+    else if (Nanoseconds < 1e6) snprintf(Text, sizeof(Text), "%.2f us", Nanoseconds / 1e3);
+    else if (Nanoseconds < 1e9) snprintf(Text, sizeof(Text), "%.2f ms", Nanoseconds / 1e6);
+    else snprintf(Text, sizeof(Text), "%.2f s", Nanoseconds / 1e9);
+    return Text;
+}
+
+bool Save(const std::vector<Result>& Results, const std::string& Path) {
+    std::ofstream File(Path);
+    if (!File.is_open()) return false;
+    File << "microbench 1\n";
+    for (const Result& R : Results) {
+        File << R.Name << ' ' << R.Iterations << ' ' << R.Samples.size();
+        for (double Sample : R.Samples) File << ' ' << Sample;
+        File << '\n';
+    }
+    return true;
+}
+
+bool Load(const std::string& Path, std::map<std::string, Result>& Results) {
+    std::ifstream File(Path);
+    std::string Word;
+    int Version;
+    if (!(File >> Word >> Version) || Word != "microbench" || Version != 1) return false;
+    Result R;
+    std::size_t Count;
+    while (File >> R.Name >> R.Iterations >> Count) {
+        R.Samples.resize(Count);
+        for (double& Sample : R.Samples)
+            if (!(File >> Sample)) return false;
+        Results[R.Name] = R;
+    }
+    return true;
+}
+
+// Bootstrap interval of median(B) / median(A).
+void RatioInterval(const std::vector<double>& A, const std::vector<double>& B,
+                   double& Low, double& High) {
+    std::mt19937 Random(7);
+    std::vector<double> Ratios, ResampleA(A.size()), ResampleB(B.size());
+    for (int r = 0; r < 2000; ++r) {
+        for (double& Value : ResampleA) Value = A[Random() % A.size()];
+        for (double& Value : ResampleB) Value = B[Random() % B.size()];
+        Ratios.push_back(Median(ResampleB) / Median(ResampleA));
+    }
+    std::sort(Ratios.begin(), Ratios.end());
+    Low = Ratios[Ratios.size() * 25 / 1000];
+    High = Ratios[Ratios.size() * 975 / 1000];
+}
+
+int Compare(const Options& Opt) {
+    std::map<std::string, Result> A, B;
+    if (!Load(Opt.CompareA, A) || !Load(Opt.CompareB, B)) {
+        printf("Cannot read %s or %s.\n", Opt.CompareA.c_str(), Opt.CompareB.c_str());
+        return 2;
+    }
+    int Regressions = 0;
+    printf("%-40s %12s %12s %8s %19s\n", "benchmark", "A", "B", "B/A", "95% interval");
+    for (const auto& Before : A) {
+        auto After = B.find(Before.first);
+        if (After == B.end() || Before.second.Samples.empty() || After->second.Samples.empty()) continue;
+        double MedianA = Median(Before.second.Samples), MedianB = Median(After->second.Samples);
+        double Low, High;
+        RatioInterval(Before.second.Samples, After->second.Samples, Low, High);
+        const char* Verdict = "";
+        if (Low > 1 + Opt.Threshold) { Verdict = "REGRESSION"; ++Regressions; }
+        else if (High < 1 - Opt.Threshold) Verdict = "faster";
+        printf("%-40s %12s %12s %8.3f [%8.3f,%8.3f] %s\n", Before.first.c_str(),
+               Human(MedianA).c_str(), Human(MedianB).c_str(), MedianB / MedianA, Low, High, Verdict);
+    }
+    printf("%d significant regression(s) above %.1f%%.\n", Regressions, Opt.Threshold * 100);
+    return Regressions > 0 ? 1 : 0;
+}
+
+bool StartsWith(const char* Text, const char* Prefix, const char*& Rest) {
+    std::size_t Length = strlen(Prefix);
+    if (strncmp(Text, Prefix, Length) != 0) return false;
+    Rest = Text + Length;
+    return true;
+}
+
+} // namespace
+
+State::State(uint64_t Iterations, int64_t Arg)
+    : Remaining(Iterations), Total(Iterations), Argument(Arg),
+      Paused(0), Elapsed(0) {}
+
+Registrar::Registrar(const char* Name, Function Run, std::initializer_list<int64_t> Args) {
+    if (Args.size() == 0) {
+        Registry().push_back(Entry{Name, Run, 0});
+        return;
+    }
+    for (int64_t Arg : Args)
+        Registry().push_back(Entry{std::string(Name) + "/" + std::to_string(Arg), Run, Arg});
+}
+
+double Median(std::vector<double> Values) {
+    if (Values.empty()) return 0.0;
+    std::size_t Mid = Values.size() / 2;
+    std::nth_element(Values.begin(), Values.begin() + Mid, Values.end());
+    if (Values.size() % 2 == 1) return Values[Mid];
+    double Upper = Values[Mid];
+    return (*std::max_element(Values.begin(), Values.begin() + Mid) + Upper) / 2;
+}
+
+void BootstrapInterval(const std::vector<double>& Values, double& Low, double& High,
+                       int Resamples, double Level) {
+    Low = High = Median(Values);
+    if (Values.size() < 2) return;
+    std::mt19937 Random(7);
+    std::vector<double> Medians, Resample(Values.size());
+    for (int r = 0; r < Resamples; ++r) {
+        for (double& Value : Resample) Value = Values[Random() % Values.size()];
+        Medians.push_back(Median(Resample));
+    }
+    std::sort(Medians.begin(), Medians.end());
+    Low = Medians[static_cast<std::size_t>((1 - Level) / 2 * (Resamples - 1))];
+    High = Medians[static_cast<std::size_t>((1 + Level) / 2 * (Resamples - 1))];
+}
+
+int Main(int args, char** argv) {
+    Options Opt;
+    for (int i = 1; i < args; ++i) {
+        const char* Value;
+        if (StartsWith(argv[i], "--filter=", Value)) Opt.Filter = Value;
+        else if (StartsWith(argv[i], "--samples=", Value)) Opt.Samples = std::max(2, atoi(Value));
+        else if (StartsWith(argv[i], "--min-time=", Value)) Opt.MinTime = atof(Value) / 1000;
+        else if (StartsWith(argv[i], "--threshold=", Value)) Opt.Threshold = atof(Value) / 100;
+        else if (StartsWith(argv[i], "--pin=", Value)) Opt.Pin = atoi(Value);
+        else if (StartsWith(argv[i], "--out=", Value)) Opt.Out = Value;
+        else if (StartsWith(argv[i], "--compare=", Value)) {
+            const char* Comma = strchr(Value, ',');
+            if (Comma == nullptr) {
+                printf("--compare needs two files: --compare=<a>,<b>.\n");
+                return 2;
+            }
+            Opt.CompareA.assign(Value, Comma);
+            Opt.CompareB = Comma + 1;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            for (const Entry& E : Registry()) printf("%s\n", E.Name.c_str());
+            return 0;
+        } else {
+            printf("Unknown option %s.\n"
+                   "Options: --filter=<text> --samples=<n> --min-time=<ms> --pin=<cpu>\n"
+                   "         --out=<file> --compare=<a>,<b> --threshold=<%%> --list\n", argv[i]);
+            return 2;
+        }
+    }
+    if (!Opt.CompareA.empty()) return Compare(Opt);
+
+    CheckMachine(Opt);
+    std::vector<Result> Results;
+    printf("%-40s %12s %25s %12s\n", "benchmark", "median", "95% interval", "iterations");
+    for (const Entry& E : Registry()) {
+        if (E.Name.find(Opt.Filter) == std::string::npos) continue;
+        Result R = Measure(E, Opt);
+        double Low, High;
+        BootstrapInterval(R.Samples, Low, High);
+        printf("%-40s %12s [%11s,%11s] %12llu\n", R.Name.c_str(), Human(Median(R.Samples)).c_str(),
+               Human(Low).c_str(), Human(High).c_str(), static_cast<unsigned long long>(R.Iterations));
+        fflush(stdout);
+        Results.push_back(R);
+    }
+    if (!Opt.Out.empty() && !Save(Results, Opt.Out)) {
+        printf("Cannot write %s.\n", Opt.Out.c_str());
+        return 2;
+    }
+    return 0;
+}
+
+} // namespace MicroBench
@@ -0,0 +1,102 @@
+// Header file of MicroBench - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef MICROBENCH_HPP
+#define MICROBENCH_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+//==============================================================================
+
+// Microbenchmark framework. A benchmark is a function looping on
+// State.KeepRunning(); only that loop is timed:
+//
+//     MICROBENCH(SortSmall) {
+//         std::vector<int> Input = ...;              // not timed
+//         while (State.KeepRunning()) {
+//             std::vector<int> Copy = Input;
+//             std::sort(Copy.begin(), Copy.end());
+//             MicroBench::DoNotOptimize(Copy);
+//         }
+//     }
+//     MICROBENCH_ARGS(SortSized, 1000, 100000) { ... State.Arg() ... }
+//
+// and the app's main returns MicroBench::Main(args, argv). The iteration
+// count is calibrated so one sample lasts --min-time ms, then --samples
+// samples are taken; the report gives the median time per iteration with a
+// bootstrap 95% confidence interval. --out=<file> saves the samples,
+// --compare=<a>,<b> compares two saved runs and flags the significant
+// regressions (exit status 1 when there is one).
+namespace MicroBench {
+
+class State{
+    uint64_t Remaining, Total;
+    int64_t Argument;
+    std::chrono::steady_clock::time_point Start;
+    std::chrono::nanoseconds Paused;
+    std::chrono::steady_clock::time_point PauseStart;
+    std::chrono::nanoseconds Elapsed;
+ public:
+     State(uint64_t Iterations, int64_t Arg);
+     bool KeepRunning() {
+         if (Remaining == Total) Start = std::chrono::steady_clock::now();
+         if (Remaining-- != 0) return true;
+         Elapsed = std::chrono::steady_clock::now() - Start - Paused;
+         return false;
+     }
+     // Excludes per-iteration setup from the time (costs two clock reads).
+     void PauseTiming() { PauseStart = std::chrono::steady_clock::now(); }
+     void ResumeTiming() { Paused += std::chrono::steady_clock::now() - PauseStart; }
+     uint64_t Iterations() const { return Total; }
+     int64_t Arg() const { return Argument; }
+     double Seconds() const { return std::chrono::duration<double>(Elapsed).count(); }
+};
+
+typedef void (*Function)(State&);
+
+struct Registrar{
+    Registrar(const char* Name, Function Run, std::initializer_list<int64_t> Args = {});
+};
+
+// Keep Value (and the work producing it) from being optimized away.
+template<class T>
+inline void DoNotOptimize(const T& Value) { asm volatile("" : : "r,m"(Value) : "memory"); }
+template<class T>
+inline void DoNotOptimize(T& Value) { asm volatile("" : "+r,m"(Value) : : "memory"); }
+// Forces pending writes to memory to be considered observed.
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+// Samples of one benchmark, nanoseconds per iteration.
+struct Result{
+    std::string Name;
+    uint64_t Iterations;
+    std::vector<double> Samples;
+};
+
+double Median(std::vector<double> Values);
+// Bootstrap percentile interval of the median (95% by default).
+void BootstrapInterval(const std::vector<double>& Values, double& Low, double& High,
+                       int Resamples = 2000, double Level = 0.95);
+
+int Main(int args, char** argv);
+
+} // namespace MicroBench
+
+#define MICROBENCH_CONCAT2(A, B) A##B
+#define MICROBENCH_CONCAT(A, B) MICROBENCH_CONCAT2(A, B)
+#define MICROBENCH(Name) \
+    static void Name(MicroBench::State& State); \
+    static MicroBench::Registrar MICROBENCH_CONCAT(Name, Registrar)(#Name, Name); \
+    static void Name(MicroBench::State& State)
+// One benchmark per argument, State.Arg() gives it.
+#define MICROBENCH_ARGS(Name, ...) \
+    static void Name(MicroBench::State& State); \
+    static MicroBench::Registrar MICROBENCH_CONCAT(Name, Registrar)(#Name, Name, {__VA_ARGS__}); \
+    static void Name(MicroBench::State& State)
+
+#endif // ifndef MICROBENCH_HPP
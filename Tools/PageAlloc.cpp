@@ -0,0 +1,109 @@
+// Implementation file for PageBuffer - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "PageAlloc.hpp"
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+//==============================================================================
+
+namespace {
+
+const std::size_t HugePage = 2 << 20;
+
+std::size_t RoundUp(std::size_t Bytes, std::size_t Unit) {
+    return (Bytes + Unit - 1) / Unit * Unit;
+}
+
+} // namespace
+
+bool ParsePagePolicy(const std::string& Name, PagePolicy& Policy) {
+    if (Name == "default") Policy = PagePolicy::Default;
+    else if (Name == "thp") Policy = PagePolicy::Transparent;
+    else if (Name == "huge") Policy = PagePolicy::Explicit;
+    else return false;
+    return true;
+}
+
+const char* PagePolicyName(PagePolicy Policy) {
+    switch (Policy) {
+        case PagePolicy::Transparent: return "thp";
+        case PagePolicy::Explicit: return "huge";
+        default: return "default";
+    }
+}
+
+PageBuffer::PageBuffer(): Base(nullptr), Length(0), Backing(PagePolicy::Default) {}
+PageBuffer::~PageBuffer() { Release(); }
+
+bool PageBuffer::Allocate(std::size_t Bytes, PagePolicy Policy) {
+    Release();
+    if (Bytes == 0) return false;
+    const int Flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (Policy == PagePolicy::Explicit) {
+        Length = RoundUp(Bytes, HugePage);
+        void* Map = mmap(nullptr, Length, PROT_READ | PROT_WRITE, Flags | MAP_HUGETLB, -1, 0);
+        if (Map != MAP_FAILED) {
+            Base = Map;
+            Backing = PagePolicy::Explicit;
+            return true;
+        }
+        Policy = PagePolicy::Transparent; // no reserved huge pages
+    }
+
+    if (Policy == PagePolicy::Default) {
+        Length = RoundUp(Bytes, sysconf(_SC_PAGESIZE));
+        void* Map = mmap(nullptr, Length, PROT_READ | PROT_WRITE, Flags, -1, 0);
+        if (Map == MAP_FAILED) {
+            Length = 0;
+            return false;
+        }
+        Base = Map;
+        return true;
+    }
+
+    // Transparent: huge pages only cover 2 MiB aligned ranges, so the
+    // mapping is made one huge page larger and trimmed to an aligned start.
+    Length = RoundUp(Bytes, HugePage);
+    void* Map = mmap(nullptr, Length + HugePage, PROT_READ | PROT_WRITE, Flags, -1, 0);
+    if (Map == MAP_FAILED) {
+        Length = 0;
+        return false;
+    }
+    const uintptr_t Start = reinterpret_cast<uintptr_t>(Map);
+    const uintptr_t Aligned = RoundUp(Start, HugePage);
+    const std::size_t Head = Aligned - Start, Tail = HugePage - Head;
+    if (Head > 0) munmap(Map, Head);
+    if (Tail > 0) munmap(reinterpret_cast<void*>(Aligned + Length), Tail);
+    Base = reinterpret_cast<void*>(Aligned);
+    Backing = PagePolicy::Default;
+    if (madvise(Base, Length, MADV_HUGEPAGE) == 0) Backing = PagePolicy::Transparent;
+    return true;
+}
+
+void PageBuffer::Release() {
+    if (Base != nullptr) munmap(Base, Length);
+    Base = nullptr;
+    Length = 0;
+    Backing = PagePolicy::Default;
+}
+
+void PageBuffer::Prefault(unsigned Threads) {
+    if (Base == nullptr) return;
+    if (Threads == 0) Threads = 1;
+    const std::size_t Page = sysconf(_SC_PAGESIZE);
+    const std::size_t Pages = Length / Page;
+    std::vector<std::thread> Workers;
+    for (unsigned t = 0; t < Threads; ++t) {
+        Workers.emplace_back([this, t, Threads, Page, Pages]() {
+            // A write fault maps the page (or the whole huge page).
+            volatile char* Bytes = static_cast<volatile char*>(Base);
+            for (std::size_t p = Pages * t / Threads; p < Pages * (t + 1) / Threads; ++p)
+                Bytes[p * Page] = 0;
+        });
+    }
+    for (std::thread& Worker : Workers) Worker.join();
+}
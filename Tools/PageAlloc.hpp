@@ -0,0 +1,44 @@
+// Header file of PageBuffer - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef PAGEALLOC_HPP
+#define PAGEALLOC_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+#include <cstddef>
+//==============================================================================
+
+// Which pages back a large buffer.
+//   Default     : normal 4 KiB pages.
+//   Transparent : transparent huge pages, asked with madvise(MADV_HUGEPAGE).
+//   Explicit    : reserved huge pages (MAP_HUGETLB), falls back to
+//                 Transparent when none are available.
+enum class PagePolicy { Default, Transparent, Explicit };
+
+// "default", "thp" or "huge". False for anything else.
+bool ParsePagePolicy(const std::string& Name, PagePolicy& Policy);
+const char* PagePolicyName(PagePolicy Policy);
+
+// Zero filled anonymous memory mapped with a page policy.
+class PageBuffer{
+    void* Base;
+    std::size_t Length;
+    PagePolicy Backing;
+ public:
+     PageBuffer();
+     PageBuffer(const PageBuffer&) = delete;
+     PageBuffer& operator=(const PageBuffer&) = delete;
+     ~PageBuffer();
+     bool Allocate(std::size_t Bytes, PagePolicy Policy);
+     void Release();
+     void* Data() const { return Base; }
+     std::size_t Size() const { return Length; }
+     // The policy actually obtained (after fallbacks).
+     PagePolicy Backed() const { return Backing; }
+     // Touches every page from Threads threads at once, so the page faults
+     // are taken now and in parallel instead of one by one on first use.
+     void Prefault(unsigned Threads);
+};
+
+#endif // ifndef PAGEALLOC_HPP
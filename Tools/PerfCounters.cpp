@@ -0,0 +1,68 @@
+// Implementation file for PerfCounters - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "PerfCounters.hpp"
+#include <cstring>
+#include <initializer_list>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+//==============================================================================
+
+namespace {
+
+int OpenCounter(uint32_t Type, uint64_t Config) {
+    perf_event_attr Attr;
+    memset(&Attr, 0, sizeof(Attr));
+    Attr.size = sizeof(Attr);
+    Attr.type = Type;
+    Attr.config = Config;
+    Attr.disabled = 1;
+    Attr.inherit = 1;        // threads started while counting
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &Attr, 0, -1, -1, 0);
+}
+
+uint64_t ReadCounter(int Fd) {
+    uint64_t Value = 0;
+    if (read(Fd, &Value, sizeof(Value)) != sizeof(Value)) return 0;
+    return Value;
+}
+
+uint64_t ProcessFaults() {
+    rusage Usage;
+    getrusage(RUSAGE_SELF, &Usage);
+    return Usage.ru_minflt + Usage.ru_majflt;
+}
+
+} // namespace
+
+PerfCounters::PerfCounters(): Tlb(0), Faults(0), FaultsAtStart(0) {
+    TlbFd = OpenCounter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    FaultFd = OpenCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+}
+
+PerfCounters::~PerfCounters() {
+    if (TlbFd >= 0) close(TlbFd);
+    if (FaultFd >= 0) close(FaultFd);
+}
+
+void PerfCounters::Start() {
+    for (int Fd : {TlbFd, FaultFd}) {
+        if (Fd < 0) continue;
+        ioctl(Fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(Fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    FaultsAtStart = ProcessFaults();
+}
+
+void PerfCounters::Stop() {
+    for (int Fd : {TlbFd, FaultFd})
+        if (Fd >= 0) ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0);
+    Tlb = (TlbFd >= 0) ? ReadCounter(TlbFd) : 0;
+    Faults = (FaultFd >= 0) ? ReadCounter(FaultFd) : ProcessFaults() - FaultsAtStart;
+}
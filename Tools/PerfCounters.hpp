@@ -0,0 +1,30 @@
+// Header file of PerfCounters - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <cstdint>
+//==============================================================================
+
+// dTLB load misses and page faults between Start and Stop, for the calling
+// thread and the threads it starts meanwhile. The TLB counter needs
+// perf_event_open; when it is not allowed HasTlb is false. Page faults then
+// come from getrusage (whole process).
+class PerfCounters{
+    int TlbFd, FaultFd;
+    uint64_t Tlb, Faults, FaultsAtStart;
+ public:
+     PerfCounters();
+     PerfCounters(const PerfCounters&) = delete;
+     PerfCounters& operator=(const PerfCounters&) = delete;
+     ~PerfCounters();
+     void Start();
+     void Stop();
+     bool HasTlb() const { return TlbFd >= 0; }
+     uint64_t TlbMisses() const { return Tlb; }
+     uint64_t PageFaults() const { return Faults; }
+};
+
+#endif // ifndef PERFCOUNTERS_HPP
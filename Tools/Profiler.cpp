@@ -0,0 +1,236 @@
+// Implementation file for Profiler - shared tools
+// Author: Salah Eddine Ghamri
+//==============================================================================
+#include "Profiler.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <unistd.h>
+//==============================================================================
+
+namespace {
+
+const int MaxDepth = 48;
+const std::size_t MaxSamples = 1 << 18; // 4 min at 1 kHz, mapped on use
+const uintptr_t MaxFrameSize = 1 << 20;
+const uintptr_t MaxStackSize = uintptr_t(1) << 30;
+
+struct Sample{
+    std::atomic<int> Depth; // written last, 0 while incomplete
+    uintptr_t Pc[MaxDepth];
+};
+
+Sample* Samples = nullptr;
+std::atomic<std::size_t> Taken(0);
+std::atomic<bool> Running(false);
+std::string Output;
+uintptr_t MainStackTop = 0;           // end of the main thread's stack
+thread_local uintptr_t StackTop = 0;  // same for this thread, 1 if unknown
+
+// Reads two words at Address without faulting: a frame pointer register may
+// hold anything in code built without frame pointers. Only used when the
+// stack bounds of the thread are unknown.
+bool ReadFrame(uintptr_t Address, uintptr_t Words[2]) {
+    iovec Local{Words, 2 * sizeof(uintptr_t)};
+    iovec Remote{reinterpret_cast<void*>(Address), 2 * sizeof(uintptr_t)};
+    return process_vm_readv(getpid(), &Local, 1, &Remote, 1, 0) == 2 * sizeof(uintptr_t);
+}
+
+void ReadRegisters(void* Context, uintptr_t& Pc, uintptr_t& Frame, uintptr_t& Stack) {
+    const mcontext_t& M = static_cast<ucontext_t*>(Context)->uc_mcontext;
+#if defined(__x86_64__)
+    Pc = M.gregs[REG_RIP];
+    Frame = M.gregs[REG_RBP];
+    Stack = M.gregs[REG_RSP];
+#elif defined(__aarch64__)
+    Pc = M.pc;
+    Frame = M.regs[29];
+    Stack = M.sp;
+#else
+    Pc = 0;
+    Frame = 0;
+    Stack = 0;
+    (void)M;
+#endif
+}
+
+uintptr_t ThreadStackTop() {
+    // Found once per thread, with async-signal-safe calls only. glibc puts
+    // the descriptor of a thread (pthread_self) right above its stack; the
+    // main thread's stack end is looked up by Start.
+    if (StackTop == 0) {
+        const bool Main = syscall(SYS_gettid) == getpid();
+        StackTop = Main ? MainStackTop : reinterpret_cast<uintptr_t>(pthread_self());
+        if (StackTop == 0) StackTop = 1;
+    }
+    return StackTop;
+}
+
+void OnSignal(int, siginfo_t*, void* Context) {
+    // Async-signal-safe: no allocation, no locks.
+    if (!Running.load(std::memory_order_relaxed)) return;
+    std::size_t Slot = Taken.fetch_add(1, std::memory_order_relaxed);
+    if (Slot >= MaxSamples) return;
+    Sample& S = Samples[Slot];
+
+    uintptr_t Pc, Frame, Stack;
+    ReadRegisters(Context, Pc, Frame, Stack);
+    int Depth = 0;
+    S.Pc[Depth++] = Pc;
+    // Frame layout: [Frame] = caller frame, [Frame + 8] = return address.
+    // A frame must be aligned, on the stack and a little above the previous
+    // one, which stops the walk at code built without frame pointers.
+    // Between the stack pointer and the stack top every word is mapped, so
+    // frames there are read directly; a system call per frame otherwise
+    // (unknown thread, signal or coroutine stack).
+    const uintptr_t Top = ThreadStackTop();
+    const bool Bounded = Top > Stack && Top - Stack < MaxStackSize;
+    uintptr_t Words[2];
+    while (Depth < MaxDepth && Frame >= Stack && Frame % sizeof(uintptr_t) == 0) {
+        if (Bounded) {
+            if (Frame > Top - sizeof(Words)) break;
+            memcpy(Words, reinterpret_cast<const void*>(Frame), sizeof(Words));
+        } else if (!ReadFrame(Frame, Words)) {
+            break;
+        }
+        uintptr_t Return = Words[1], Next = Words[0];
+        if (Return < 4096) break; // not a code address
+        S.Pc[Depth++] = Return - 1; // inside the call instruction
+        if (Next <= Frame || Next - Frame > MaxFrameSize) break;
+        Frame = Next;
+    }
+    S.Depth.store(Depth, std::memory_order_release);
+}
+
+std::string Symbol(uintptr_t Pc) {
+    Dl_info Info;
+    memset(&Info, 0, sizeof(Info));
+    char Text[64];
+    if (dladdr(reinterpret_cast<void*>(Pc), &Info) == 0 || Info.dli_sname == nullptr) {
+        if (Info.dli_fname != nullptr) {
+            // Offset in the module, for addr2line.
+            snprintf(Text, sizeof(Text), "0x%lx", static_cast<unsigned long>(
+                     Pc - reinterpret_cast<uintptr_t>(Info.dli_fbase)));
+            const char* Name = strrchr(Info.dli_fname, '/');
+            return std::string(Name ? Name + 1 : Info.dli_fname) + "+" + Text;
+        }
+        snprintf(Text, sizeof(Text), "0x%lx", static_cast<unsigned long>(Pc));
+        return Text;
+    }
+    int Status = 0;
+    char* Demangled = abi::__cxa_demangle(Info.dli_sname, nullptr, nullptr, &Status);
+    std::string Name = (Status == 0 && Demangled != nullptr) ? Demangled : Info.dli_sname;
+    free(Demangled);
+    // ';' separates frames in the folded format.
+    for (char& c : Name) if (c == ';') c = ':';
+    return Name;
+}
+
+void WriteFolded() {
+    const std::size_t Count = std::min(Taken.load(), MaxSamples);
+    std::unordered_map<uintptr_t, std::string> Names;
+    std::map<std::string, std::size_t> Stacks;
+    for (std::size_t s = 0; s < Count; ++s) {
+        int Depth = Samples[s].Depth.load(std::memory_order_acquire);
+        if (Depth == 0) continue;
+        std::string Stack;
+        // Outermost caller first.
+        for (int d = Depth - 1; d >= 0; --d) {
+            uintptr_t Pc = Samples[s].Pc[d];
+            auto Found = Names.find(Pc);
+            if (Found == Names.end()) Found = Names.emplace(Pc, Symbol(Pc)).first;
+            if (!Stack.empty()) Stack += ';';
+            Stack += Found->second;
+        }
+        ++Stacks[Stack];
+    }
+    FILE* File = fopen(Output.c_str(), "w");
+    if (File == nullptr) {
+        fprintf(stderr, "Profiler: cannot write %s.\n", Output.c_str());
+        return;
+    }
+    for (const auto& Stack : Stacks) fprintf(File, "%s %zu\n", Stack.first.c_str(), Stack.second);
+    fclose(File);
+    if (Taken.load() > MaxSamples)
+        fprintf(stderr, "Profiler: buffer full, %zu samples dropped.\n", Taken.load() - MaxSamples);
+}
+
+void StopAtExit() { Profiler::Stop(); }
+
+// Starts the profiler before main when TASK_PROFILE is set.
+struct AutoStart{
+    AutoStart() {
+        const char* Path = getenv("TASK_PROFILE");
+        if (Path == nullptr || *Path == '\0') return;
+        const char* Rate = getenv("TASK_PROFILE_HZ");
+        Profiler::Start(Path, Rate ? atoi(Rate) : 1000);
+    }
+} AutoStarter;
+
+} // namespace
+
+bool Profiler::Start(const std::string& OutputPath, int Hertz) {
+    if (Running.load() || Hertz <= 0 || Hertz > 1000000) return false;
+    if (Samples == nullptr) {
+        void* Map = mmap(nullptr, sizeof(Sample) * MaxSamples, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (Map == MAP_FAILED) return false;
+        Samples = static_cast<Sample*>(Map);
+        atexit(StopAtExit);
+    }
+    Output = OutputPath;
+    Taken.store(0);
+    if (MainStackTop == 0 && syscall(SYS_gettid) == getpid()) {
+        // Called from the main thread (before main with TASK_PROFILE).
+        pthread_attr_t Attributes;
+        if (pthread_getattr_np(pthread_self(), &Attributes) == 0) {
+            void* Base = nullptr;
+            std::size_t Size = 0;
+            if (pthread_attr_getstack(&Attributes, &Base, &Size) == 0)
+                MainStackTop = reinterpret_cast<uintptr_t>(Base) + Size;
+            pthread_attr_destroy(&Attributes);
+        }
+    }
+
+    struct sigaction Action;
+    memset(&Action, 0, sizeof(Action));
+    Action.sa_sigaction = OnSignal;
+    Action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&Action.sa_mask);
+    if (sigaction(SIGPROF, &Action, nullptr) != 0) return false;
+
+    Running.store(true);
+    itimerval Timer;
+    const long Period = 1000000 / Hertz; // microseconds
+    Timer.it_interval.tv_sec = Period / 1000000;
+    Timer.it_interval.tv_usec = (Period > 0) ? Period % 1000000 : 1;
+    Timer.it_value = Timer.it_interval;
+    if (setitimer(ITIMER_PROF, &Timer, nullptr) != 0) {
+        Running.store(false);
+        return false;
+    }
+    return true;
+}
+
+void Profiler::Stop() {
+    if (!Running.exchange(false)) return;
+    itimerval Timer;
+    memset(&Timer, 0, sizeof(Timer));
+    setitimer(ITIMER_PROF, &Timer, nullptr);
+    signal(SIGPROF, SIG_IGN);
+    WriteFolded();
+}
@@ -0,0 +1,34 @@
+// Header file of Profiler - shared tools
+// Author: Salah Eddine Ghamri
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+//==============================================================================
+// Included dependencies:
+#include <string>
+//==============================================================================
+
+// In-process sampling CPU profiler.
+// Linking Profiler.cpp into an app is enough: when the environment variable
+// TASK_PROFILE names an output file, sampling starts before main and the
+// folded stacks ("main;Caller;Callee <samples>", the flamegraph.pl input)
+// are written at exit. TASK_PROFILE_HZ sets the rate (default 1000).
+//
+// SIGPROF comes from ITIMER_PROF, which counts the CPU time of all threads
+// and is delivered to the thread that is running; the kernel checks it on
+// every tick, so rates above CONFIG_HZ give CONFIG_HZ. The handler walks the
+// frame pointers (build with -fno-omit-frame-pointer) into preallocated
+// slots taken with one atomic increment, reading frames directly between
+// the stack pointer and the thread's stack top; symbols are resolved at
+// exit with dladdr (link with -rdynamic to see the functions of the app
+// itself). A sample costs about 2 us (signal delivery and a 20 frame
+// walk), 0.2% of one core at 1 kHz.
+namespace Profiler {
+
+bool Start(const std::string& OutputPath, int Hertz);
+// Stops sampling and writes the folded stacks. Called at exit if needed.
+void Stop();
+
+} // namespace Profiler
+
+#endif // ifndef PROFILER_HPP
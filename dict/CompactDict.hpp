@@ -0,0 +1,200 @@
+// Header file of CompactDict - insertion ordered hash map
+// Author: Salah Eddine Ghamri
+#ifndef COMPACTDICT_HPP
+#define COMPACTDICT_HPP
+
+// include dependecies =========================================================
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+//==============================================================================
+// Hash map with the layout of the CPython 3.7+ dict:
+//   Entries : dense array of (hash, key, value) in insertion order, so
+//             iteration is a walk over contiguous memory.
+//   Index   : sparse open addressing table of positions in Entries, each
+//             1, 2, 4 or 8 bytes wide depending on the table size (a table
+//             of 8 slots costs 8 bytes). Probing is CPython's: i = 5 i +
+//             perturb + 1, perturb >>= 5, so every slot is reached and the
+//             upper hash bits take part.
+// At most 2/3 of the index slots are used. Erase leaves a dummy in the
+// index and a hole in Entries, both are removed lazily by the next resize
+// (which compacts Entries in order) - iteration skips the holes meanwhile.
+// Keys and values must be default constructible: an erased entry is reset
+// to defaults so that what it owned is freed at once.
+//==============================================================================
+
+template<class K, class V, class Hash = std::hash<K>, class Equal = std::equal_to<K>>
+class CompactDict{
+ public:
+     struct Entry{
+         std::size_t Code;             // Hole for an erased entry
+         K Key;
+         V Value;
+     };
+ private:
+     // Real hashes have the top bit cleared, so Hole never matches one.
+     static const std::size_t Hole = ~static_cast<std::size_t>(0);
+     static const int64_t Empty = -1, Dummy = -2;
+     std::vector<Entry> Entries;
+     std::vector<unsigned char> Index;
+     std::size_t Slots;                // index size, a power of 2
+     unsigned Width;                   // bytes per index slot
+     std::size_t Live;
+     Hash Hasher;
+     Equal Same;
+
+     static std::size_t CodeOf(std::size_t h) { return h & (Hole >> 1); }
+     static unsigned WidthFor(std::size_t Slots) {
+         if (Slots <= 0x80) return 1;
+         if (Slots <= 0x8000) return 2;
+         if (Slots <= 0x80000000ull) return 4;
+         return 8;
+     }
+     int64_t Get(std::size_t s) const {
+         const unsigned char* At = Index.data() + s * Width;
+         switch (Width) {
+         case 1: { int8_t v; std::memcpy(&v, At, 1); return v; }
+         case 2: { int16_t v; std::memcpy(&v, At, 2); return v; }
+         case 4: { int32_t v; std::memcpy(&v, At, 4); return v; }
+         default: { int64_t v; std::memcpy(&v, At, 8); return v; }
+         }
+     }
+     void Put(std::size_t s, int64_t Value) {
+         unsigned char* At = Index.data() + s * Width;
+         switch (Width) {
+         case 1: { int8_t v = Value; std::memcpy(At, &v, 1); break; }
+         case 2: { int16_t v = Value; std::memcpy(At, &v, 2); break; }
+         case 4: { int32_t v = Value; std::memcpy(At, &v, 4); break; }
+         default: std::memcpy(At, &Value, 8);
+         }
+     }
+     // Index slot holding Key, or the first free slot of its probe sequence
+     // (an empty one, or the first dummy met before it) when it is absent.
+     std::size_t Probe(const K& Key, std::size_t Code, bool& Found) const {
+         const std::size_t Mask = Slots - 1;
+         std::size_t s = Code & Mask, Perturb = Code, Free = Slots;
+         while (true) {
+             const int64_t e = Get(s);
+             if (e == Empty) {
+                 Found = false;
+                 return Free != Slots ? Free : s;
+             }
+             if (e == Dummy) {
+                 if (Free == Slots) Free = s;
+             } else if (Entries[e].Code == Code && Same(Entries[e].Key, Key)) {
+                 Found = true;
+                 return s;
+             }
+             Perturb >>= 5;
+             s = (s * 5 + Perturb + 1) & Mask;
+         }
+     }
+     // Compacts Entries and rebuilds an index for at least Wanted entries.
+     void Resize(std::size_t Wanted) {
+         std::size_t Size = 8;
+         while (Size * 2 < Wanted * 3) Size <<= 1;
+         if (Live != Entries.size()) {
+             std::size_t Kept = 0;
+             for (std::size_t e = 0; e < Entries.size(); ++e)
+                 if (Entries[e].Code != Hole) {
+                     if (Kept != e) Entries[Kept] = std::move(Entries[e]);
+                     ++Kept;
+                 }
+             Entries.resize(Kept);
+         }
+         Slots = Size;
+         Width = WidthFor(Size);
+         Index.assign(Slots * Width, 0xFF); // every width reads -1
+         Entries.reserve(Slots * 2 / 3);
+         const std::size_t Mask = Slots - 1;
+         for (std::size_t e = 0; e < Entries.size(); ++e) {
+             std::size_t s = Entries[e].Code & Mask, Perturb = Entries[e].Code;
+             while (Get(s) != Empty) {
+                 Perturb >>= 5;
+                 s = (s * 5 + Perturb + 1) & Mask;
+             }
+             Put(s, e);
+         }
+     }
+ public:
+     CompactDict(): Slots(0), Width(1), Live(0) { Resize(0); }
+     std::size_t Size() const { return Live; }
+     // Bytes held by the index and the entries (capacity included).
+     std::size_t MemoryBytes() const { return Index.capacity() + Entries.capacity() * sizeof(Entry); }
+     void Reserve(std::size_t Count) { if (Count * 3 > Slots * 2) Resize(Count); }
+
+     V* Find(const K& Key) {
+         bool Found;
+         std::size_t s = Probe(Key, CodeOf(Hasher(Key)), Found);
+         return Found ? &Entries[Get(s)].Value : nullptr;
+     }
+     const V* Find(const K& Key) const { return const_cast<CompactDict*>(this)->Find(Key); }
+
+     // Inserts or overwrites. Returns true if Key was new.
+     bool Insert(const K& Key, const V& Value) {
+         std::pair<V*, bool> At = Place(Key);
+         *At.first = Value;
+         return At.second;
+     }
+     // Value of Key, inserted default constructed if absent (a new key goes
+     // last in the order, an existing one keeps its place).
+     V& operator[](const K& Key) { return *Place(Key).first; }
+
+     bool Erase(const K& Key) {
+         bool Found;
+         std::size_t s = Probe(Key, CodeOf(Hasher(Key)), Found);
+         if (!Found) return false;
+         Entry& Gone = Entries[Get(s)];
+         Put(s, Dummy);
+         Gone.Code = Hole;
+         Gone.Key = K();
+         Gone.Value = V();
+         --Live;
+         return true;
+     }
+
+     // Forward iteration in insertion order, over Entry (Key, Value).
+     template<class E>
+     class Walker{
+         E* At;
+         E* End;
+         void Skip() { while (At != End && At->Code == Hole) ++At; }
+      public:
+          Walker(E* Begin, E* Stop): At(Begin), End(Stop) { Skip(); }
+          E& operator*() const { return *At; }
+          E* operator->() const { return At; }
+          Walker& operator++() { ++At; Skip(); return *this; }
+          bool operator!=(const Walker& Other) const { return At != Other.At; }
+          bool operator==(const Walker& Other) const { return At == Other.At; }
+     };
+     Walker<Entry> begin() { return Walker<Entry>(Entries.data(), Entries.data() + Entries.size()); }
+     Walker<Entry> end() { return Walker<Entry>(Entries.data() + Entries.size(), Entries.data() + Entries.size()); }
+     Walker<const Entry> begin() const {
+         return Walker<const Entry>(Entries.data(), Entries.data() + Entries.size());
+     }
+     Walker<const Entry> end() const {
+         return Walker<const Entry>(Entries.data() + Entries.size(), Entries.data() + Entries.size());
+     }
+ private:
+     // Value of Key, appended default constructed if absent (second true).
+     std::pair<V*, bool> Place(const K& Key) {
+         const std::size_t Code = CodeOf(Hasher(Key));
+         bool Found;
+         std::size_t s = Probe(Key, Code, Found);
+         if (Found) return std::make_pair(&Entries[Get(s)].Value, false);
+         // Entries is full at 2/3 of the index, holes included: the resize
+         // drops the holes and sizes the index for twice the live entries.
+         if (Entries.size() >= Slots * 2 / 3) {
+             Resize(Live * 2 > Live + 1 ? Live * 2 : Live + 1);
+             s = Probe(Key, Code, Found);
+         }
+         Put(s, Entries.size());
+         Entries.push_back(Entry{Code, Key, V()});
+         ++Live;
+         return std::make_pair(&Entries.back().Value, true);
+     }
+};
+
+#endif // ifndef COMPACTDICT_HPP
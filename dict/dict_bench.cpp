@@ -0,0 +1,92 @@
+// CompactDict against std::map and std::unordered_map, int64 keys and
+// values inserted in random order: heap bytes per entry, insert, lookup and
+// iteration times, iteration again after erasing half of the keys.
+// dict_bench.py does the same with a Python dict.
+// Build: g++ -O2 -std=c++14 dict_bench.cpp -o dict_bench
+// "./dict_bench [entries]"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CompactDict.hpp"
+
+// Heap in use (malloc overhead included), to see what a container really
+// holds: small blocks plus the mmap'ed large ones.
+static std::size_t Heap()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template<class F>
+double Milliseconds(F work)
+{
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Adapters: the same five steps on every container.
+template<class M> void Put(M& m, int64_t k, int64_t v) { m[k] = v; }
+template<class M> int64_t Get(M& m, int64_t k) { return m.find(k)->second; }
+template<class M> void Drop(M& m, int64_t k) { m.erase(k); }
+template<class M> int64_t Sum(const M& m)
+{
+    int64_t s = 0;
+    for (const auto& e : m) s += e.second;
+    return s;
+}
+typedef CompactDict<int64_t, int64_t> Compact;
+template<> int64_t Get(Compact& m, int64_t k) { return *m.Find(k); }
+template<> void Drop(Compact& m, int64_t k) { m.Erase(k); }
+template<> int64_t Sum(const Compact& m)
+{
+    int64_t s = 0;
+    for (const auto& e : m) s += e.Value;
+    return s;
+}
+
+template<class M>
+void Run(const char* name, const std::vector<int64_t>& keys, const std::vector<int64_t>& probes)
+{
+    const std::size_t before = Heap();
+    M* m = new M;
+    double insert = Milliseconds([&]() { for (int64_t k : keys) Put(*m, k, k * 3); });
+    const double bytes = static_cast<double>(Heap() - before) / keys.size();
+    int64_t found = 0, full = 0, half = 0;
+    double lookup = Milliseconds([&]() { for (int64_t k : probes) found += Get(*m, k); });
+    double iterate = Milliseconds([&]() { full = Sum(*m); });
+    for (int64_t k : keys)
+        if (k / 7919 % 2 == 0) Drop(*m, k);
+    double holes = Milliseconds([&]() { half = Sum(*m); });
+    delete m;
+    printf("%-14s %10.1f %10.1f %10.1f %10.2f %12.2f   %lld %lld %lld\n", name, bytes, insert, lookup,
+           iterate, holes, static_cast<long long>(found), static_cast<long long>(full),
+           static_cast<long long>(half));
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 random(42);
+    std::vector<int64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int64_t>(i) * 7919;
+    std::shuffle(keys.begin(), keys.end(), random);
+    std::vector<int64_t> probes = keys;
+    std::shuffle(probes.begin(), probes.end(), random);
+
+    printf("%zu entries (times in ms, then the lookup and iteration sums):\n", n);
+    printf("%-14s %10s %10s %10s %10s %12s\n", "container", "bytes/entry", "insert", "lookup",
+           "iterate", "after erase");
+    Run<Compact>("CompactDict", keys, probes);
+    Run<std::unordered_map<int64_t, int64_t>>("unordered_map", keys, probes);
+    Run<std::map<int64_t, int64_t>>("map", keys, probes);
+    return 0;
+}
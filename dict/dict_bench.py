@@ -0,0 +1,55 @@
+"""Python dict side of dict_bench.cpp: same keys, values and steps.
+
+usage: python dict_bench.py [entries]
+bytes/entry is the dict itself (sys.getsizeof) and, in brackets, with the
+int objects it created (tracemalloc), which C++ stores inline.
+"""
+import random
+import sys
+import time
+import tracemalloc
+
+
+def milliseconds(work):
+    start = time.perf_counter()
+    result = work()
+    return (time.perf_counter() - start) * 1000, result
+
+
+def main():
+    n = int(sys.argv[1]) if len(sys.argv) > 1 else 1000000
+    rng = random.Random(42)
+    keys = [i * 7919 for i in range(n)]
+    rng.shuffle(keys)
+    probes = keys[:]
+    rng.shuffle(probes)
+
+    tracemalloc.start()
+    before = tracemalloc.get_traced_memory()[0]
+    d = {}
+
+    def insert():
+        for k in keys:
+            d[k] = k * 3
+    insert_ms, _ = milliseconds(insert)
+    total = (tracemalloc.get_traced_memory()[0] - before) / n
+    tracemalloc.stop()
+    own = sys.getsizeof(d) / n
+    def lookup():
+        found = 0
+        for k in probes:
+            found += d[k]
+        return found
+    lookup_ms, found = milliseconds(lookup)
+    iterate_ms, full = milliseconds(lambda: sum(d.values()))
+    for k in keys:
+        if k // 7919 % 2 == 0:
+            del d[k]
+    holes_ms, half = milliseconds(lambda: sum(d.values()))
+    print("%-14s %10.1f %10.1f %10.1f %10.2f %12.2f   %d %d %d   [%.1f with ints]" % (
+        "python dict", own, insert_ms, lookup_ms,
+        iterate_ms, holes_ms, found, full, half, total))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,45 @@
+// Lock acquisition latency of a contended std::mutex.
+// Build: g++ -O2 -I../Tools lock_bench.cpp ../Tools/Histogram.cpp -pthread -o lock_bench
+// Usage: ./lock_bench [threads] [iterations per thread]
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "Histogram.hpp"
+
+using namespace std;
+
+long long myAmount = 0;
+mutex m;
+
+void addMoney(int iterations, Histogram& wait){
+  for (int i = 0; i < iterations; ++i) {
+    auto start = chrono::steady_clock::now();
+    m.lock();
+    auto acquired = chrono::steady_clock::now();
+    // critical section
+    ++myAmount;
+    m.unlock();
+    wait.Record(chrono::duration_cast<chrono::nanoseconds>(acquired - start).count());
+  }
+}
+
+int main(int argc, char** argv){
+  int threads = (argc > 1) ? stoi(argv[1]) : thread::hardware_concurrency();
+  int iterations = (argc > 2) ? stoi(argv[2]) : 100000;
+  // One histogram per thread, merged after the join.
+  vector<unique_ptr<Histogram>> waits;
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t) waits.emplace_back(new Histogram);
+  for (int t = 0; t < threads; ++t) workers.emplace_back(addMoney, iterations, ref(*waits[t]));
+  for (thread& worker : workers) worker.join();
+
+  Histogram all;
+  for (auto& wait : waits) all.Merge(*wait);
+  cout << threads << " threads, myAmount = " << myAmount << endl;
+  all.Print("lock acquisition");
+  return 0;
+}